@@ -667,6 +667,11 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
 
+        ifeq ($(strip $(SPLIT_TELEMETRY_ENABLE)), yes)
+            OPT_DEFS += -DSPLIT_TELEMETRY_ENABLE
+            QUANTUM_SRC += $(QUANTUM_DIR)/split_common/split_telemetry.c
+        endif
+
         # Functions added via QUANTUM_LIB_SRC are only included in the final binary if they're called.
         # Unused functions are pruned away, which is why we can add multiple drivers here without bloat.
         ifeq ($(PLATFORM),AVR)
@@ -36,6 +36,7 @@ GENERIC_FEATURES = \
     HAPTIC \
     KEY_LOCK \
     KEY_OVERRIDE \
+    LATENCY_TRACE \
     LEADER \
     MAGIC \
     MOUSEKEY \
@@ -49,6 +50,8 @@ GENERIC_FEATURES = \
     SPACE_CADET \
     SWAP_HANDS \
     TAP_DANCE \
+    TASK_PROFILING \
+    TICKLESS_IDLE \
     TRI_LAYER \
     VIA \
     VIRTSER \
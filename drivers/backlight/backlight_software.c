@@ -52,3 +52,8 @@ void backlight_task(void) {
     }
     backlight_tick = (backlight_tick + 1) % 16;
 }
+
+uint32_t backlight_time_until_next(void) {
+    // Only a fully off or fully on pattern can be left alone
+    return (s_duty_pattern == 0 || s_duty_pattern == UINT16_MAX) ? UINT32_MAX : 0;
+}
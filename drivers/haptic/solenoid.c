@@ -140,6 +140,26 @@ void solenoid_check(void) {
     }
 }
 
+/**
+ * @brief Time until an active solenoid next needs to be checked
+ *
+ */
+uint32_t solenoid_time_until_next(void) {
+    uint32_t next = UINT32_MAX;
+
+    for (uint8_t i = 0; i < NUMBER_OF_SOLENOIDS; i++) {
+        if (!solenoid_on[i]) continue;
+
+        // Buzzing toggles the solenoid every few milliseconds
+        if (haptic_config.buzz) return 0;
+
+        uint16_t elapsed = timer_elapsed(solenoid_start[i]);
+        if (elapsed > haptic_config.dwell) return 0;
+        if (next > haptic_config.dwell - elapsed + 1) next = haptic_config.dwell - elapsed + 1;
+    }
+    return next;
+}
+
 /**
  * @brief Initial configuration for solenoids
  *
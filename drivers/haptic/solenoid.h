@@ -64,7 +64,8 @@ void solenoid_stop(uint8_t index);
 void solenoid_fire(uint8_t index);
 void solenoid_fire_handler(void);
 
-void solenoid_check(void);
+void     solenoid_check(void);
+uint32_t solenoid_time_until_next(void);
 
 void solenoid_setup(void);
 void solenoid_shutdown(void);
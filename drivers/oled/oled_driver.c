@@ -30,6 +30,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <string.h>
 #include "progmem.h"
 #include "wait.h"
+#include "util.h"
 
 // Used commands from spec sheet: https://cdn-shop.adafruit.com/datasheets/SSD1306.pdf
 // for SH1106: https://www.velleman.eu/downloads/29/infosheets/sh1106_datasheet.pdf
@@ -968,6 +969,38 @@ void oled_task(void) {
 #endif
 }
 
+static inline uint32_t oled_time_until(uint32_t deadline) {
+    int32_t remaining = (int32_t)TIMER_DIFF_32(deadline, timer_read32());
+    return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+uint32_t oled_time_until_next(void) {
+    uint32_t next = UINT32_MAX;
+    if (!oled_initialized) {
+        return next;
+    }
+
+    if (oled_active) {
+#if OLED_UPDATE_INTERVAL > 0
+        uint16_t elapsed = timer_elapsed(oled_update_timeout);
+        next             = elapsed < OLED_UPDATE_INTERVAL ? OLED_UPDATE_INTERVAL - elapsed : 0;
+#else
+        // oled_task_user() is run on every pass while the display is on
+        return 0;
+#endif
+#if OLED_TIMEOUT > 0
+        next = MIN(next, oled_time_until(oled_timeout));
+#endif
+    }
+
+#if OLED_SCROLL_TIMEOUT > 0
+    if (!oled_scrolling) {
+        next = MIN(next, oled_time_until(oled_scroll_timeout));
+    }
+#endif
+    return next;
+}
+
 __attribute__((weak)) bool oled_task_kb(void) {
     return oled_task_user();
 }
@@ -446,6 +446,9 @@ uint8_t oled_get_brightness(void);
 // Basically it's oled_render, but with timeout management and oled_task_user calling!
 void oled_task(void);
 
+// Time until oled_task next has something to do, or UINT32_MAX if nothing is pending
+uint32_t oled_time_until_next(void);
+
 // Called at the start of oled_task, weak function overridable by the user
 bool oled_task_kb(void);
 bool oled_task_user(void);
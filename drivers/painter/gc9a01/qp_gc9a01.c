@@ -105,6 +105,7 @@ const tft_panel_dc_reset_painter_driver_vtable_t gc9a01_driver_vtable = {
             .palette_convert = qp_tft_panel_palette_convert_rgb565_swapped,
             .append_pixels   = qp_tft_panel_append_pixels_rgb565,
             .append_pixdata  = qp_tft_panel_append_pixdata,
+            .pixdata_async   = qp_tft_panel_pixdata_async,
         },
     .num_window_bytes   = 2,
     .swap_window_coords = false,
@@ -21,6 +21,22 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_TILE_SIZE
+/**
+ * @def The width and height in pixels of the tiles used to track which parts of a surface have been drawn to, must be a
+ *      power of two. Only dirty tiles are transferred by qp_surface_draw(). Surfaces too large to be covered by 32 columns
+ *      and SURFACE_DIRTY_TILE_ROWS rows of tiles use larger tiles.
+ */
+#    define SURFACE_DIRTY_TILE_SIZE 16
+#endif
+
+#ifndef SURFACE_DIRTY_TILE_ROWS
+/**
+ * @def The maximum number of rows of dirty tiles tracked for each surface. Each row requires 4 bytes of RAM.
+ */
+#    define SURFACE_DIRTY_TILE_ROWS 20
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
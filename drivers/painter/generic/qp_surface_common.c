@@ -30,6 +30,13 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
 }
 
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
+    // Mark the tile containing the pixel
+    uint16_t row = y >> dirty->tile_shift;
+    uint16_t col = x >> dirty->tile_shift;
+    if (row < SURFACE_DIRTY_TILE_ROWS && col < 32) {
+        dirty->tiles[row] |= ((uint32_t)1) << col;
+    }
+
     // Maintain dirty region
     if (dirty->l > x) {
         dirty->l        = x;
@@ -49,6 +56,42 @@ void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y
     }
 }
 
+bool qp_surface_transfer_dirty_tiles(surface_painter_device_t *surface, painter_driver_t *target_driver, uint16_t x, uint16_t y, surface_rect_transfer_func transfer) {
+    surface_dirty_data_t *dirty = &surface->dirty;
+    uint16_t              size  = 1 << dirty->tile_shift;
+    uint16_t              row0  = dirty->t >> dirty->tile_shift;
+    uint16_t              row1  = dirty->b >> dirty->tile_shift;
+
+    for (uint16_t row = row0; row <= row1 && row < SURFACE_DIRTY_TILE_ROWS; ++row) {
+        uint32_t tiles = dirty->tiles[row];
+        uint16_t t     = row * size;
+        uint16_t b     = t + size - 1;
+        if (t < dirty->t) t = dirty->t;
+        if (b > dirty->b) b = dirty->b;
+
+        // Send each run of adjacent dirty tiles in one go, saving viewport updates
+        while (tiles) {
+            uint8_t first = __builtin_ctzl(tiles);
+            uint8_t last  = first;
+            while (last < 31 && (tiles & (((uint32_t)1) << (last + 1)))) {
+                last++;
+            }
+            tiles &= ~((((uint32_t)2) << last) - 1);
+
+            uint16_t l = first * size;
+            uint16_t r = (last + 1) * size - 1;
+            if (l < dirty->l) l = dirty->l;
+            if (r > dirty->r) r = dirty->r;
+            if (l > r) continue;
+
+            if (!transfer(surface, target_driver, x, y, l, t, r, b)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Driver vtable
 
@@ -57,11 +100,18 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
     memset(surface->buffer, 0, SURFACE_REQUIRED_BUFFER_BYTE_SIZE(driver->panel_width, driver->panel_height, driver->native_bits_per_pixel));
 
+    // Grow the tiles until the grid covers the whole surface
+    surface->dirty.tile_shift = __builtin_ctz(SURFACE_DIRTY_TILE_SIZE);
+    while (((driver->panel_width - 1) >> surface->dirty.tile_shift) >= 32 || ((driver->panel_height - 1) >> surface->dirty.tile_shift) >= SURFACE_DIRTY_TILE_ROWS) {
+        surface->dirty.tile_shift++;
+    }
+
     surface->dirty.l        = 0;
     surface->dirty.t        = 0;
     surface->dirty.r        = surface->base.panel_width - 1;
     surface->dirty.b        = surface->base.panel_height - 1;
     surface->dirty.is_dirty = true;
+    memset(surface->dirty.tiles, 0xFF, sizeof(surface->dirty.tiles));
 
     return true;
 }
@@ -83,6 +133,7 @@ bool qp_surface_flush(painter_device_t device) {
     surface->dirty.l = surface->dirty.t = UINT16_MAX;
     surface->dirty.r = surface->dirty.b = 0;
     surface->dirty.is_dirty             = false;
+    memset(surface->dirty.tiles, 0, sizeof(surface->dirty.tiles));
     return true;
 }
 
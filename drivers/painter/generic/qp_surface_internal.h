@@ -22,6 +22,10 @@ typedef struct surface_dirty_data_t {
     uint16_t t;
     uint16_t r;
     uint16_t b;
+
+    // One bit per dirty tile, one word per row of tiles
+    uint8_t  tile_shift;
+    uint32_t tiles[SURFACE_DIRTY_TILE_ROWS];
 } surface_dirty_data_t;
 
 typedef struct surface_viewport_data_t {
@@ -90,6 +94,12 @@ bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, u
 void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport);
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y);
 
+// Transfers a rectangle of the surface, in surface coordinates, to the target's viewport at the same offset from (x, y)
+typedef bool (*surface_rect_transfer_func)(surface_painter_device_t *surface, painter_driver_t *target_driver, uint16_t x, uint16_t y, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
+
+// Invokes the transfer function for each horizontal run of dirty tiles, clipped to the dirty region
+bool qp_surface_transfer_dirty_tiles(surface_painter_device_t *surface, painter_driver_t *target_driver, uint16_t x, uint16_t y, surface_rect_transfer_func transfer);
+
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
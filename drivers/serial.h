@@ -28,6 +28,19 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+// number of transactions which can be queued in the background
+#    ifndef SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE
+#        define SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE 4
+#    endif
+// queue a transaction to run in the background, tried up to attempts times before the next one starts
+// returns false if the queue is full
+bool soft_serial_transaction_begin(int sstd_index, uint8_t attempts);
+// wait for the oldest background transaction, returns true if there was none
+bool soft_serial_transaction_end(void);
+bool soft_serial_transaction_busy(void);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
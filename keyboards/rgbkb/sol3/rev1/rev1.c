@@ -31,6 +31,13 @@ RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+void rgb_matrix_adjust_hsv_batch(HSV *hsv, uint8_t count) {
+    if (!limit_lightning) return;
+    for (uint8_t i = 0; i < count; i++) {
+        hsv[i].v /= 2;
+    }
+}
+
 bool dip_switch_update_kb(uint8_t index, bool active) {
     if (!dip_switch_update_user(index, active))
         return false;
@@ -89,7 +89,7 @@ void keyboard_post_init_kb(void) {
 // RGB brightness scaling dependent on USBPD state
 
 #if defined(RGB_MATRIX_ENABLE)
-RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+static float rgb_matrix_brightness_scale(void) {
     float scale;
 
 #    ifdef DJINN_SUPPORTS_3A_FUSE
@@ -120,9 +120,20 @@ RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     }
 #    endif
 
-    hsv.v = (uint8_t)(hsv.v * scale);
+    return scale;
+}
+
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    hsv.v = (uint8_t)(hsv.v * rgb_matrix_brightness_scale());
     return hsv_to_rgb(hsv);
 }
+
+void rgb_matrix_adjust_hsv_batch(HSV *hsv, uint8_t count) {
+    float scale = rgb_matrix_brightness_scale();
+    for (uint8_t i = 0; i < count; i++) {
+        hsv[i].v = (uint8_t)(hsv[i].v * scale);
+    }
+}
 #endif
 
 //----------------------------------------------------------
@@ -239,6 +239,8 @@ def convert_image_bytes(im, format):
         # Export the palette
         palette = []
         pal = im.getpalette()
+        # Newer Pillow versions only return the colours in use, so pad the rest out with black
+        pal += [0] * (ncolors * 3 - len(pal))
         for n in range(0, ncolors * 3, 3):
             palette.append((pal[n + 0], pal[n + 1], pal[n + 2]))
 
@@ -6,9 +6,10 @@
 # See https://docs.qmk.fm/#/quantum_painter_qgf for more information.
 
 import functools
+import math
 from colorsys import rgb_to_hsv
 from types import FunctionType
-from PIL import Image, ImageFile, ImageChops
+from PIL import Image, ImageFile, ImageChops, ImageOps
 from PIL._binary import o8, o16le as o16, o32le as o32
 import qmk.painter
 
@@ -147,6 +148,17 @@ class QGFFrameDescriptorV1:
         else:
             self.flags &= ~0x02
 
+    @property
+    def is_continued(self):
+        return (self.flags & 0x04) == 0x04
+
+    @is_continued.setter
+    def is_continued(self, val):
+        if val:
+            self.flags |= 0x04
+        else:
+            self.flags &= ~0x04
+
 
 ########################################################################################################################
 
@@ -260,79 +272,170 @@ def _for_all_frames(x: FunctionType, /, images):
             frame_num += 1
 
 
-def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwargs):
-    # Convert the original frame so we can do comparisons
-    converted = qmk.painter.convert_requested_format(frame, format_)
+# Upper limit on the number of delta frames a single animation frame is split into
+_MAX_DELTA_REGIONS = 8
+
+
+def _displayed_pixels(frame, format_):
+    """Approximates what the panel shows for a frame, so that changes lost in conversion don't need redrawing.
+    """
+    image_format = format_['image_format']
+    if image_format == 'IMAGE_FORMAT_GRAYSCALE':
+        maxval = format_['num_colors'] - 1
+        return ImageOps.grayscale(frame).point(lambda v: qmk.painter.rescale_byte(v, maxval))
+    if image_format == 'IMAGE_FORMAT_RGB565':
+        return frame.point([v & 0xF8 for v in range(256)] + [v & 0xFC for v in range(256)] + [v & 0xF8 for v in range(256)])
+
+    # Palettes are picked for each frame separately, so there's nothing better to compare than the original
+    return frame
+
+
+def _split_region(mask, box, overhead_pixels):
+    """Splits a region at its widest gap of unchanged rows or columns, if skipping that gap saves more than the cost of another delta frame.
+    """
+    region = mask.crop(box)
+    best = None
+    for axis, projection in enumerate(region.getprojection()):
+        gap_start = None
+        for i, changed in enumerate(projection):
+            if not changed and gap_start is None:
+                gap_start = i
+            elif changed and gap_start is not None:
+                saved = (i - gap_start) * (region.height if axis == 0 else region.width)
+                if best is None or saved > best[0]:
+                    best = (saved, axis, gap_start, i)
+                gap_start = None
+
+    if best is None or best[0] <= overhead_pixels:
+        return None
+
+    _, axis, gap_start, gap_end = best
+    left, top, right, bottom = box
+    if axis == 0:
+        halves = [(left, top, left + gap_start, bottom), (left + gap_end, top, right, bottom)]
+    else:
+        halves = [(left, top, right, top + gap_start), (left, top + gap_end, right, bottom)]
+
+    # Trim each half down to its own changes
+    return [(h[0] + bb[0], h[1] + bb[1], h[0] + bb[2], h[1] + bb[3]) for h in halves for bb in [mask.crop(h).getbbox()]]
+
+
+def _delta_regions(frame, last_frame, format_):
+    """Works out the rectangles of a frame which need redrawing after the last one, as PIL boxes.
+    """
+    diff = ImageChops.difference(_displayed_pixels(frame, format_), _displayed_pixels(last_frame, format_))
+    mask = functools.reduce(ImageChops.lighter, diff.split())
+
+    # Frames identical to the last one still need an entry, so redraw a single pixel rather than the whole frame
+    bbox = mask.getbbox()
+    if not bbox:
+        return [(0, 0, 1, 1)]
+
+    # Each extra delta frame costs its descriptors and frame offset, plus its own palette if the format has one
+    overhead_bytes = _frame_overhead_bytes(format_, is_delta=True)
+    overhead_pixels = overhead_bytes * 8 // int(math.log2(format_['num_colors']))
+
+    # Split regions apart wherever that avoids redrawing enough unchanged pixels
+    regions = []
+    pending = [bbox]
+    while pending:
+        box = pending.pop()
+        halves = _split_region(mask, box, overhead_pixels) if len(regions) + len(pending) + 1 < _MAX_DELTA_REGIONS else None
+        if halves:
+            pending.extend(halves)
+        else:
+            regions.append(box)
+
+    return sorted(regions, key=lambda box: (box[1], box[0]))
+
+
+def _frame_overhead_bytes(format_, *, is_delta):
+    """Works out how many bytes a frame takes up in the file, besides its image data.
+    """
+    # Frame offset, frame descriptor and frame data header
+    overhead_bytes = 4 + QGFBlockHeader.block_size + QGFFrameDescriptorV1.length + QGFBlockHeader.block_size
+    if format_['has_palette']:
+        overhead_bytes += QGFBlockHeader.block_size + format_['num_colors'] * 3
+    if is_delta:
+        overhead_bytes += QGFBlockHeader.block_size + QGFFrameDeltaDescriptorV1.length
+    return overhead_bytes
+
+
+def _encode_image(image, *, use_rle, format_):
+    # Convert the image to the requested format
+    converted = qmk.painter.convert_requested_format(image, format_)
     graphic_data = qmk.painter.convert_image_bytes(converted, format_)
 
-    # Convert the raw data to RLE-encoded if requested
+    # Convert the raw data to RLE-encoded if requested, and if it's smaller
     raw_data = graphic_data[1]
     if use_rle:
         rle_data = qmk.painter.compress_bytes_qmk_rle(graphic_data[1])
     use_raw_this_frame = not use_rle or len(raw_data) <= len(rle_data)
     image_data = raw_data if use_raw_this_frame else rle_data
 
-    # Work out if a delta frame is smaller than injecting it directly
-    use_delta_this_frame = False
-    bbox = None
-    if use_deltas and last_frame is not None:
-        # If we want to use deltas, then find the difference
-        diff = ImageChops.difference(frame, last_frame)
-
-        # Get the bounding box of those differences
-        bbox = diff.getbbox()
-
-        # If we have a valid bounding box...
-        if bbox:
-            # ...create the delta frame by cropping the original.
-            delta_frame = frame.crop(bbox)
-
-            # Convert the delta frame to the requested format
-            delta_converted = qmk.painter.convert_requested_format(delta_frame, format_)
-            delta_graphic_data = qmk.painter.convert_image_bytes(delta_converted, format_)
-
-            # Work out how large the delta frame is going to be with compression etc.
-            delta_raw_data = delta_graphic_data[1]
-            if use_rle:
-                delta_rle_data = qmk.painter.compress_bytes_qmk_rle(delta_graphic_data[1])
-            delta_use_raw_this_frame = not use_rle or len(delta_raw_data) <= len(delta_rle_data)
-            delta_image_data = delta_raw_data if delta_use_raw_this_frame else delta_rle_data
-
-            # If the size of the delta frame (plus delta descriptor) is smaller than the original, use that instead
-            # This ensures that if a non-delta is overall smaller in size, we use that in preference due to flash
-            # sizing constraints.
-            if (len(delta_image_data) + QGFFrameDeltaDescriptorV1.length) < len(image_data):
-                # Copy across all the delta equivalents so that the rest of the processing acts on those
-                graphic_data = delta_graphic_data
-                raw_data = delta_raw_data
-                rle_data = delta_rle_data
-                use_raw_this_frame = delta_use_raw_this_frame
-                image_data = delta_image_data
-                use_delta_this_frame = True
-
-        # Default to whole image
-        bbox = bbox or [0, 0, *frame.size]
-        # Fix sze (as per #20296), we need to cast first as tuples are inmutable
-        bbox = list(bbox)
-        bbox[2] -= 1
-        bbox[3] -= 1
-
-    return {
-        "bbox": bbox,
+    return graphic_data, image_data, use_raw_this_frame
+
+
+def _compress_image(frame, last_frame, *, use_rle, use_deltas, prefer_deltas, format_, **_kwargs):
+    """Encodes an animation frame, returning the information for each QGF frame it's written as.
+
+    When deltas are in use, only the parts of the frame which changed since the last one are encoded, potentially as
+    several delta frames. All of them but the last one are marked as continued, so that they are drawn together.
+    """
+    delay = frame.info.get('duration', 1000)  # If we're not an animation, just pretend we're delaying for 1000ms
+
+    graphic_data, image_data, use_raw_this_frame = _encode_image(frame, use_rle=use_rle, format_=format_)
+    full_frame = [{
+        "bbox": [0, 0, frame.size[0] - 1, frame.size[1] - 1],
+        "delay": delay,
         "graphic_data": graphic_data,
         "image_data": image_data,
-        "use_delta_this_frame": use_delta_this_frame,
+        "use_continued_this_frame": False,
+        "use_delta_this_frame": False,
         "use_raw_this_frame": use_raw_this_frame,
-    }
+    }]
+
+    if not use_deltas or last_frame is None:
+        return full_frame
+
+    # Changes spanning the whole frame are drawn as a regular frame
+    regions = _delta_regions(frame, last_frame, format_)
+    if regions == [(0, 0, *frame.size)]:
+        return full_frame
+
+    delta_frames = []
+    for n, region in enumerate(regions):
+        # Create the delta frame by cropping the original
+        graphic_data, image_data, use_raw_this_frame = _encode_image(frame.crop(region), use_rle=use_rle, format_=format_)
+
+        # Fix size (as per #20296), QGF uses inclusive coordinates
+        bbox = [region[0], region[1], region[2] - 1, region[3] - 1]
+
+        # Continued frames keep a nonzero delay, as firmware predating the flag waits between each of them
+        is_last = n == len(regions) - 1
+        delta_frames.append({
+            "bbox": bbox,
+            "delay": delay if is_last else 1,
+            "graphic_data": graphic_data,
+            "image_data": image_data,
+            "use_continued_this_frame": not is_last,
+            "use_delta_this_frame": True,
+            "use_raw_this_frame": use_raw_this_frame,
+        })
+
+    # Unless asked to favour sending fewer pixels, only use the delta frames if they're smaller in flash than the full
+    # frame, due to flash sizing constraints
+    if not prefer_deltas:
+        full_size = _frame_overhead_bytes(format_, is_delta=False) + len(full_frame[0]["image_data"])
+        delta_size = sum(_frame_overhead_bytes(format_, is_delta=True) + len(f["image_data"]) for f in delta_frames)
+        if delta_size >= full_size:
+            return full_frame
+
+    return delta_frames
 
 
 # Helper function to save each frame to the output file
-def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, **kwargs):
-    # Not an argument of the function as it would consume from **kwargs
-    format_ = kwargs["format_"]
-
-    # (potentially) Apply RLE and/or delta, and work out output image's information
-    outputs = _compress_image(frame, last_frame, **kwargs)
+def _write_frame(idx, outputs, *, fp, frame_offsets, format_):
     bbox = outputs["bbox"]
     graphic_data = outputs["graphic_data"]
     image_data = outputs["image_data"]
@@ -344,10 +447,11 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, **kwargs):
     vprint(f'{f"Frame {idx:3d} base":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_descriptor = QGFFrameDescriptorV1()
     frame_descriptor.is_delta = use_delta_this_frame
+    frame_descriptor.is_continued = outputs["use_continued_this_frame"]
     frame_descriptor.is_transparent = False
     frame_descriptor.format = format_['image_format_byte']
     frame_descriptor.compression = 0x00 if use_raw_this_frame else 0x01  # See qp.h, painter_compression_t
-    frame_descriptor.delay = frame.info.get('duration', 1000)  # If we're not an animation, just pretend we're delaying for 1000ms
+    frame_descriptor.delay = outputs["delay"]
     frame_descriptor.write(fp)
 
     # Write out the palette if required
@@ -400,11 +504,16 @@ def _save(im, fp, _filename):
     if len(set(frame_sizes)) != 1:
         raise ValueError("Mismatching sizes on frames")
 
+    # (potentially) Apply RLE and/or delta to each frame up front, as a frame may be split into several delta frames
+    compress_image = functools.partial(_compress_image, format_=encoderinfo["qmk_format"], use_deltas=encoderinfo.get("use_deltas", True), prefer_deltas=encoderinfo.get("prefer_deltas", False), use_rle=encoderinfo.get("use_rle", True))
+    frame_outputs = []
+    for_all_frames(lambda _idx, frame, last_frame: frame_outputs.extend(compress_image(frame, last_frame)))
+
     # Write out the initial graphics descriptor (and write a dummy value), so that we can come back and fill in the
     # correct values once we've written all the frames to the output
     graphics_descriptor_location = fp.tell()
     graphics_descriptor = QGFGraphicsDescriptor()
-    graphics_descriptor.frame_count = len(frame_sizes)
+    graphics_descriptor.frame_count = len(frame_outputs)
     graphics_descriptor.image_size = frame_sizes[0]
     vprint(f'{"Graphics descriptor block":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     graphics_descriptor.write(fp)
@@ -416,9 +525,9 @@ def _save(im, fp, _filename):
     vprint(f'{"Frame offsets block":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_offsets.write(fp)
 
-    # Iterate over each if the input frames, writing it to the output in the process
-    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets)
-    for_all_frames(write_frame)
+    # Iterate over each of the output frames, writing it to the output in the process
+    for idx, outputs in enumerate(frame_outputs):
+        _write_frame(idx, outputs, fp=fp, frame_offsets=frame_offsets, format_=encoderinfo["qmk_format"])
 
     # Go back and update the graphics descriptor now that we can determine the final file size
     graphics_descriptor.total_file_size = fp.tell()
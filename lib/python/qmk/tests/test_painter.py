@@ -0,0 +1,13 @@
+from PIL import Image
+
+import qmk.painter
+
+
+def test_convert_image_bytes_pads_palette():
+    format = qmk.painter.valid_formats['pal16']
+    im = qmk.painter.convert_requested_format(Image.new('RGB', (4, 4), (10, 20, 30)), format)
+    palette, image_bytes = qmk.painter.convert_image_bytes(im, format)
+    assert len(palette) == 16
+    assert palette[0] == (10, 20, 30)
+    assert palette[1:] == [(0, 0, 0)] * 15
+    assert image_bytes == [0] * 8
@@ -0,0 +1,122 @@
+from io import BytesIO
+import struct
+
+from PIL import Image, ImageDraw
+
+import qmk.painter
+import qmk.painter_qgf  # noqa: F401 -- registers the QGF format with PIL
+
+mono16 = qmk.painter.valid_formats['mono16']
+
+
+def _animation():
+    """Two 32x16 frames, with changes in opposite corners of the second one.
+    """
+    first = Image.new('RGB', (32, 16), (0, 0, 0))
+    first.info['duration'] = 100
+    second = first.copy()
+    draw = ImageDraw.Draw(second)
+    draw.rectangle((0, 0, 4, 4), fill=(255, 255, 255))
+    draw.rectangle((27, 11, 31, 15), fill=(128, 128, 128))
+    second.info['duration'] = 200
+    return [first, second]
+
+
+def _convert(frames, **kwargs):
+    out = BytesIO()
+    frames[0].save(out, 'QGF', append_images=frames[1:], qmk_format=mono16, **kwargs)
+    return out.getvalue()
+
+
+def _decode_rle(data):
+    out = []
+    n = 0
+    while n < len(data):
+        count = data[n]
+        if count >= 128:
+            out.extend(data[n + 1:n + count - 126])
+            n += count - 126
+        else:
+            out.extend([data[n + 1]] * count)
+            n += 2
+    return out
+
+
+def _read_blocks(data, offset):
+    while offset < len(data):
+        type_id, neg_type_id = data[offset], data[offset + 1]
+        assert neg_type_id == (~type_id) & 0xFF
+        length = int.from_bytes(data[offset + 2:offset + 5], 'little')
+        yield offset, type_id, data[offset + 5:offset + 5 + length]
+        offset += 5 + length
+
+
+def _read_frames(data):
+    """Parses the frames of a grayscale QGF file, as (flags, delay, bbox, pixels) tuples.
+    """
+    width, height, frame_count = struct.unpack_from('<HHH', data, 17)
+    offsets = struct.unpack_from(f'<{frame_count}I', data, 28)
+
+    frames = []
+    for offset in offsets:
+        blocks = _read_blocks(data, offset)
+        _, _, descriptor = next(blocks)
+        _, flags, compression, _, delay = struct.unpack('<BBBBH', descriptor)
+        bbox = (0, 0, width - 1, height - 1)
+        if flags & 0x02:
+            _, _, delta = next(blocks)
+            bbox = struct.unpack('<HHHH', delta)
+        _, _, pixel_data = next(blocks)
+        pixel_data = list(pixel_data) if compression == 0x00 else _decode_rle(pixel_data)
+
+        # mono16 packs two pixels per byte, LSb first
+        pixels = [(byte >> shift) & 0x0F for byte in pixel_data for shift in (0, 4)]
+        frames.append((flags, delay, bbox, pixels))
+    return (width, height), frames
+
+
+def _render_steps(size, frames):
+    """Draws the frames the way qp_animate() does, returning the canvas after each animation step.
+    """
+    canvas = Image.new('L', size)
+    steps = []
+    for flags, delay, (left, top, right, bottom), pixels in frames:
+        region = Image.new('L', (right - left + 1, bottom - top + 1))
+        region.putdata(pixels[:region.width * region.height])
+        canvas.paste(region, (left, top))
+        if not flags & 0x04:
+            steps.append((delay, list(canvas.tobytes())))
+    return steps
+
+
+def _expected_steps(frames):
+    return [(frame.info['duration'], [qmk.painter.rescale_byte(v, 15) for v in frame.convert('L').tobytes()]) for frame in frames]
+
+
+def test_qgf_round_trip():
+    frames = _animation()
+    size, qgf_frames = _read_frames(_convert(frames))
+    assert _render_steps(size, qgf_frames) == _expected_steps(frames)
+
+
+def test_qgf_round_trip_without_deltas():
+    frames = _animation()
+    size, qgf_frames = _read_frames(_convert(frames, use_deltas=False))
+    assert [flags for flags, _, _, _ in qgf_frames] == [0x00, 0x00]
+    assert _render_steps(size, qgf_frames) == _expected_steps(frames)
+
+
+def test_qgf_prefer_deltas_splits_changes():
+    frames = _animation()
+    size, qgf_frames = _read_frames(_convert(frames, prefer_deltas=True))
+
+    # The second frame's changes are written as two delta frames, the first continued into the second
+    assert [(flags, delay, bbox) for flags, delay, bbox, _ in qgf_frames[1:]] == [(0x06, 1, (0, 0, 4, 4)), (0x02, 200, (27, 11, 31, 15))]
+    assert _render_steps(size, qgf_frames) == _expected_steps(frames)
+
+
+def test_qgf_deltas_only_when_smaller():
+    frames = _animation()
+    with_deltas = _convert(frames)
+    assert len(with_deltas) <= len(_convert(frames, use_deltas=False))
+    assert len(with_deltas) <= len(_convert(frames, prefer_deltas=True))
@@ -38,11 +38,60 @@ void soft_serial_target_init(void) {
     chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
 }
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+
+static SEMAPHORE_DECL(master_request, 0);
+static SEMAPHORE_DECL(master_done, 0);
+static uint8_t       master_queue_id[SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE];
+static uint8_t       master_queue_attempts[SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE];
+static volatile bool master_queue_okay[SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE];
+static uint8_t       master_queue_head  = 0; // next slot to queue a transaction in
+static uint8_t       master_queue_tail  = 0; // oldest slot not yet collected
+static uint8_t       master_queue_count = 0;
+
+/**
+ * @brief This thread runs on the master and executes the transactions queued
+ * by soft_serial_transaction_begin() one after another, so that the main loop
+ * doesn't wait on the link. A failed transaction is retried before any later
+ * one is started, so that they still reach the slave in order.
+ */
+static THD_WORKING_AREA(waMasterThread, 512);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_master");
+
+    uint8_t slot = 0;
+    while (true) {
+        chSemWait(&master_request);
+        bool okay = false;
+        for (uint8_t attempt = 1; !okay && attempt <= master_queue_attempts[slot]; attempt++) {
+            if (attempt > 1) {
+                /* Back off like the split transaction handlers do, but sleep so the main loop keeps running. */
+                chThdSleepMicroseconds(10 * attempt * attempt);
+            }
+            /* Clear the receive queue, to start with a clean slate.
+             * Parts of failed transactions or spurious bytes could still be in it. */
+            serial_transport_driver_clear();
+            okay = initiate_transaction(master_queue_id[slot]);
+        }
+        master_queue_okay[slot] = okay;
+        slot                    = (slot + 1) % SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE;
+        chSemSignal(&master_done);
+    }
+}
+
+#endif // SPLIT_TRANSPORT_ASYNC
+
 /**
  * @brief Master specific initializations.
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    /* Start transport thread. */
+    chThdCreateStatic(waMasterThread, sizeof(waMasterThread), HIGHPRIO, MasterThread, NULL);
+#endif // SPLIT_TRANSPORT_ASYNC
 }
 
 /**
@@ -100,13 +149,69 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#ifdef SPLIT_TRANSPORT_ASYNC
+    /* Queued transactions have to be collected first, so that this one is the oldest. */
+    if (soft_serial_transaction_busy()) {
+        return false;
+    }
+    return soft_serial_transaction_begin(index, 1) && soft_serial_transaction_end();
+#else
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
 
     return initiate_transaction((uint8_t)index);
+#endif // SPLIT_TRANSPORT_ASYNC
+}
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+
+/**
+ * @brief Queue a transaction from the master half to the slave half, without
+ * waiting for it to complete. Queued transactions run in order, and their
+ * buffers must be left alone until soft_serial_transaction_end() has
+ * collected them.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @param attempts How many times to try the transaction before giving up on it.
+ * @return bool false if the queue is full.
+ */
+bool soft_serial_transaction_begin(int index, uint8_t attempts) {
+    if (master_queue_count >= SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+
+    master_queue_id[master_queue_head]       = (uint8_t)index;
+    master_queue_attempts[master_queue_head] = attempts;
+    master_queue_head                        = (master_queue_head + 1) % SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE;
+    master_queue_count++;
+    chSemSignal(&master_request);
+    return true;
 }
 
+/**
+ * @brief Wait for the oldest transaction queued by soft_serial_transaction_begin().
+ *
+ * @return bool Indicates success of transaction, true if none was queued.
+ */
+bool soft_serial_transaction_end(void) {
+    if (master_queue_count == 0) {
+        return true;
+    }
+
+    chSemWait(&master_done);
+    bool okay         = master_queue_okay[master_queue_tail];
+    master_queue_tail = (master_queue_tail + 1) % SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE;
+    master_queue_count--;
+    return okay;
+}
+
+bool soft_serial_transaction_busy(void) {
+    return master_queue_count > 0;
+}
+
+#endif // SPLIT_TRANSPORT_ASYNC
+
 /**
  * @brief Initiate transaction to slave half.
  */
@@ -85,6 +85,19 @@ spi_status_t spi_read(void);
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 
+/**
+ * Start transmitting using DMA, returning before the transfer completes.
+ *
+ * The data must stay untouched until spi_transmit_wait() returns. Any other SPI operation, including
+ * spi_stop(), waits for the transfer to complete first.
+ */
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length);
+
+/**
+ * Wait for a transfer started by spi_transmit_async() to complete. Returns immediately if there is none.
+ */
+spi_status_t spi_transmit_wait(void);
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length);
 
 void spi_stop(void);
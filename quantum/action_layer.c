@@ -4,6 +4,7 @@
 #include "keyboard.h"
 #include "action.h"
 #include "encoder.h"
+#include "matrix.h"
 #include "util.h"
 #include "action_layer.h"
 
@@ -289,6 +290,60 @@ uint8_t read_source_layers_cache(keypos_t key) {
 }
 #endif
 
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+/** \brief effective layer lookup cache
+ *
+ * Remembers the layer layer_switch_get_layer() resolved for each key, for as
+ * long as the result cannot have changed.
+ */
+static uint8_t       layer_lookup_cache[MATRIX_ROWS][MATRIX_COLS];
+static matrix_row_t  layer_lookup_valid[MATRIX_ROWS];
+static layer_state_t layer_lookup_state = 0;
+
+/** \brief Clear the layer lookup cache
+ *
+ * Must be called when the keymap is changed behind the back of the cache.
+ */
+void layer_lookup_cache_clear(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        layer_lookup_valid[row] = 0;
+    }
+}
+
+/** \brief Invalidate a single key in the layer lookup cache
+ */
+void layer_lookup_cache_invalidate(keypos_t key) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        layer_lookup_valid[key.row] &= ~((matrix_row_t)1 << key.col);
+    }
+}
+
+/** \brief Update the layer lookup cache for a new layer state
+ *
+ * Only keys whose resolved layer was turned off, or which may now be covered
+ * by a newly enabled layer above it, need to be resolved again.
+ */
+static void layer_lookup_cache_set_state(layer_state_t layers) {
+    const layer_state_t turned_on  = layers & ~layer_lookup_state;
+    const layer_state_t turned_off = layer_lookup_state & ~layers;
+    layer_lookup_state             = layers;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t valid = layer_lookup_valid[row];
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (!(valid & ((matrix_row_t)1 << col))) {
+                continue;
+            }
+            const uint8_t layer = layer_lookup_cache[row][col];
+            if ((turned_off & ((layer_state_t)1 << layer)) || (turned_on >> layer) > 1) {
+                valid &= ~((matrix_row_t)1 << col);
+            }
+        }
+        layer_lookup_valid[row] = valid;
+    }
+}
+#endif
+
 /** \brief Store or get action (FIXME: Needs better summary)
  *
  * Make sure the action triggered when the key is released is the same
@@ -320,12 +375,11 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
  *
  * Gets the layer based on key info
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
 #ifndef NO_ACTION_LAYER
+static uint8_t layer_switch_resolve_layer(keypos_t key, layer_state_t layers) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +391,26 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_LOOKUP_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        if (layers != layer_lookup_state) {
+            layer_lookup_cache_set_state(layers);
+        }
+        const matrix_row_t mask = (matrix_row_t)1 << key.col;
+        if (!(layer_lookup_valid[key.row] & mask)) {
+            layer_lookup_cache[key.row][key.col] = layer_switch_resolve_layer(key, layers);
+            layer_lookup_valid[key.row] |= mask;
+        }
+        return layer_lookup_cache[key.row][key.col];
+    }
+#    endif
+    return layer_switch_resolve_layer(key, layers);
 #else
     return get_highest_layer(default_layer_state);
 #endif
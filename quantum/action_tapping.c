@@ -1,12 +1,18 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifndef NO_ACTION_TAPPING
 
 #    if defined(IGNORE_MOD_TAP_INTERRUPT_PER_KEY)
@@ -15,6 +21,10 @@
 #        error "IGNORE_MOD_TAP_INTERRUPT is no longer necessary as it is now the default behavior of mod-tap keys. Please remove it from your config."
 #    endif
 
+#    if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 255
+#        error "WAITING_BUFFER_SIZE must be between 2 and 255"
+#    endif
+
 #    ifndef COMBO_ENABLE
 #        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)))
 #    else
@@ -64,9 +74,17 @@ static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+// Matrix keys with a press or release held in the waiting buffer
+static matrix_row_t waiting_buffer_pressed[MATRIX_ROWS]  = {};
+static matrix_row_t waiting_buffer_released[MATRIX_ROWS] = {};
+// Buffered events which share their key and state with an earlier one
+static uint8_t waiting_buffer_duplicates = 0;
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
 static void waiting_buffer_clear(void);
+static void waiting_buffer_settle_overflow(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
@@ -78,14 +96,26 @@ static void debug_waiting_buffer(void);
  * FIXME: Needs doc
  */
 void action_tapping_process(keyrecord_t record) {
+#    ifdef LATENCY_TRACE_ENABLE
+    if (IS_KEYEVENT(record.event)) {
+        latency_trace_tapping_enter(record.event);
+    }
+#    endif
+
     if (process_tapping(&record)) {
         if (IS_EVENT(record.event)) {
             ac_dprintf("processed: ");
             debug_record(record);
             ac_dprintf("\n");
         }
-    } else {
-        if (!waiting_buffer_enq(record)) {
+    } else if (!waiting_buffer_enq(record)) {
+        // Make room by deciding the tapping key early, then retry
+        waiting_buffer_settle_overflow();
+        if (process_tapping(&record)) {
+            ac_dprintf("processed after overflow: ");
+            debug_record(record);
+            ac_dprintf("\n");
+        } else if (!waiting_buffer_enq(record)) {
             // clear all in case of overflow.
             ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
             clear_keyboard();
@@ -98,7 +128,7 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_deq()) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
@@ -112,6 +142,19 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+/** \brief Time until the tapping term of the current tapping key runs out
+ *
+ * \return milliseconds until the next tick event can make a decision, or UINT32_MAX if nothing is pending
+ */
+uint32_t action_tapping_time_until_next(void) {
+    if (IS_NOEVENT(tapping_key.event)) {
+        return UINT32_MAX;
+    }
+    uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), tapping_key.event.time);
+    return elapsed < term ? term - elapsed : 0;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
@@ -432,9 +475,19 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+static inline bool waiting_buffer_is_indexed(keypos_t key) {
+    return key.row < MATRIX_ROWS && key.col < MATRIX_COLS;
+}
+
+static inline matrix_row_t *waiting_buffer_index(bool pressed) {
+    return pressed ? waiting_buffer_pressed : waiting_buffer_released;
+}
+
 /** \brief Waiting buffer enq
  *
- * FIXME: Needs docs
+ * Appends a key event, and records its key position in the index.
+ *
+ * \return false if the buffer is full
  */
 bool waiting_buffer_enq(keyrecord_t record) {
     if (IS_NOEVENT(record.event)) {
@@ -449,25 +502,86 @@ bool waiting_buffer_enq(keyrecord_t record) {
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
 
+    const keypos_t key = record.event.key;
+    if (waiting_buffer_is_indexed(key)) {
+        matrix_row_t *index = waiting_buffer_index(record.event.pressed);
+        if (index[key.row] & ((matrix_row_t)1 << key.col)) {
+            waiting_buffer_duplicates++;
+        }
+        index[key.row] |= (matrix_row_t)1 << key.col;
+    }
+
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest event, and removes its key position from the index
+ * unless a later event for the same key and state is still buffered.
+ */
+void waiting_buffer_deq(void) {
+    const keyevent_t event = waiting_buffer[waiting_buffer_tail].event;
+    waiting_buffer_tail    = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+
+    if (!waiting_buffer_is_indexed(event.key)) {
+        return;
+    }
+
+    if (waiting_buffer_duplicates) {
+        for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+            if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed == waiting_buffer[i].event.pressed) {
+                waiting_buffer_duplicates--;
+                return;
+            }
+        }
+    }
+    waiting_buffer_index(event.pressed)[event.key.row] &= ~((matrix_row_t)1 << event.key.col);
+}
+
 /** \brief Waiting buffer clear
  *
  * FIXME: Needs docs
  */
 void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+    waiting_buffer_head       = 0;
+    waiting_buffer_tail       = 0;
+    waiting_buffer_duplicates = 0;
+    memset(waiting_buffer_pressed, 0, sizeof(waiting_buffer_pressed));
+    memset(waiting_buffer_released, 0, sizeof(waiting_buffer_released));
+}
+
+/** \brief Waiting buffer overflow
+ *
+ * Called when an event doesn't fit in the waiting buffer. An undecided
+ * tapping key is settled as a hold, as it would be once its tapping term
+ * expires, and the buffered events are replayed to free up space.
+ */
+void waiting_buffer_settle_overflow(void) {
+    if (tapping_key.event.pressed && tapping_key.tap.count == 0) {
+        ac_dprintf("OVERFLOW: SETTLE TAPPING KEY AS HOLD\n");
+        process_record(&tapping_key);
+        tapping_key = (keyrecord_t){0};
+        debug_tapping_key();
+    }
+
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_deq()) {
+        if (!process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+            break;
+        }
+    }
 }
 
 /** \brief Waiting buffer typed
  *
- * FIXME: Needs docs
+ * Checks whether the opposite edge of an event's key is waiting in the buffer.
  */
 bool waiting_buffer_typed(keyevent_t event) {
+    if (waiting_buffer_is_indexed(event.key)) {
+        return waiting_buffer_index(!event.pressed)[event.key.row] & ((matrix_row_t)1 << event.key.col);
+    }
+
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
         if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
             return true;
@@ -499,6 +613,12 @@ void waiting_buffer_scan_tap(void) {
         return;
     }
 
+    // early return if the tapping key has no release waiting
+    const keypos_t key = tapping_key.event.key;
+    if (waiting_buffer_is_indexed(key) && !(waiting_buffer_released[key.row] & ((matrix_row_t)1 << key.col))) {
+        return;
+    }
+
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
 #    endif
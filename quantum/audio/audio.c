@@ -375,6 +375,11 @@ bool audio_is_playing_melody(void) {
     return playing_melody;
 }
 
+uint32_t audio_time_until_next(void) {
+    // Playback is advanced from a timer interrupt, which a deeper sleep might stop
+    return (playing_note || playing_melody) ? 0 : UINT32_MAX;
+}
+
 uint8_t audio_get_number_of_active_tones(void) {
     return active_tones;
 }
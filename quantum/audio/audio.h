@@ -170,6 +170,13 @@ bool audio_is_playing_note(void);
  */
 bool audio_is_playing_melody(void);
 
+/**
+ * @brief time until the main loop is next needed for playback
+ *
+ * @return 0 while anything is playing, UINT32_MAX otherwise
+ */
+uint32_t audio_time_until_next(void);
+
 // These macros are used to allow audio_play_melody to play an array of indeterminate
 // length. This works around the limitation of C's sizeof operation on pointers.
 // The global float array for the song must be used here.
@@ -288,3 +288,13 @@ __attribute__((weak)) void backlight_init_ports(void) {}
 __attribute__((weak)) void backlight_set(uint8_t level) {}
 
 __attribute__((weak)) void backlight_task(void) {}
+
+__attribute__((weak)) uint32_t backlight_time_until_next(void) {
+#ifdef BACKLIGHT_CUSTOM
+    // A custom driver may rely on backlight_task() running on every pass
+    return 0;
+#else
+    // The PWM and timer drivers, including breathing, run from hardware timers
+    return UINT32_MAX;
+#endif
+}
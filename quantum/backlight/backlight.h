@@ -67,6 +67,8 @@ void    eeconfig_update_backlight_default(void);
 void backlight_init_ports(void);
 void backlight_set(uint8_t level);
 void backlight_task(void);
+// Time until backlight_task() next needs to run, or UINT32_MAX if it doesn't need to
+uint32_t backlight_time_until_next(void);
 
 #ifdef BACKLIGHT_BREATHING
 
@@ -40,8 +40,20 @@ void caps_word_task(void) {
 void caps_word_reset_idle_timer(void) {
     idle_timer = timer_read() + CAPS_WORD_IDLE_TIMEOUT;
 }
+
+uint32_t caps_word_time_until_next(void) {
+    if (!caps_word_active) {
+        return UINT32_MAX;
+    }
+    uint16_t now = timer_read();
+    return timer_expired(now, idle_timer) ? 0 : TIMER_DIFF_16(idle_timer, now);
+}
 #else
 void caps_word_task(void) {}
+
+uint32_t caps_word_time_until_next(void) {
+    return UINT32_MAX;
+}
 #endif // CAPS_WORD_IDLE_TIMEOUT > 0
 
 void caps_word_on(void) {
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <stdbool.h>
 
 #ifndef CAPS_WORD_IDLE_TIMEOUT
@@ -23,6 +24,9 @@
 /** @brief Matrix scan task for Caps Word feature */
 void caps_word_task(void);
 
+/** @brief Time until Caps Word next needs to check its idle timeout. */
+uint32_t caps_word_time_until_next(void);
+
 #if CAPS_WORD_IDLE_TIMEOUT > 0
 /** @brief Resets timer for Caps Word idle timeout. */
 void caps_word_reset_idle_timer(void);
@@ -0,0 +1,44 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+}
+
+TEST(Color, BatchConversionMatchesSingleConversion) {
+    HSV hsv[256];
+    RGB rgb[256];
+
+    for (uint16_t h = 0; h <= UINT8_MAX; h++) {
+        for (uint16_t s = 0; s <= UINT8_MAX; s++) {
+            for (uint16_t v = 0; v <= UINT8_MAX; v++) {
+                hsv[v] = (HSV){.h = (uint8_t)h, .s = (uint8_t)s, .v = (uint8_t)v};
+            }
+            // The count is a uint8_t, so convert the last color separately
+            hsv_to_rgb_batch(hsv, rgb, UINT8_MAX);
+            hsv_to_rgb_batch(&hsv[UINT8_MAX], &rgb[UINT8_MAX], 1);
+
+            for (uint16_t v = 0; v <= UINT8_MAX; v++) {
+                RGB expected = hsv_to_rgb(hsv[v]);
+                ASSERT_EQ(rgb[v].r, expected.r) << "h=" << h << " s=" << s << " v=" << v;
+                ASSERT_EQ(rgb[v].g, expected.g) << "h=" << h << " s=" << s << " v=" << v;
+                ASSERT_EQ(rgb[v].b, expected.b) << "h=" << h << " s=" << s << " v=" << v;
+            }
+        }
+    }
+}
+
+TEST(Color, EmptyBatchIsLeftAlone) {
+    HSV hsv = {.h = 1, .s = 2, .v = 3};
+    RGB rgb;
+    rgb.r = 4;
+    rgb.g = 5;
+    rgb.b = 6;
+
+    hsv_to_rgb_batch(&hsv, &rgb, 0);
+    EXPECT_EQ(rgb.r, 4);
+    EXPECT_EQ(rgb.g, 5);
+    EXPECT_EQ(rgb.b, 6);
+}
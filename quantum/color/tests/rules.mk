@@ -0,0 +1,12 @@
+color_DEFS :=
+
+color_SRC := \
+    $(QUANTUM_PATH)/color/tests/color.cpp \
+    $(QUANTUM_PATH)/color.c
+
+color_cie1931_DEFS := -DUSE_CIE1931_CURVE
+
+color_cie1931_SRC := \
+    $(QUANTUM_PATH)/color/tests/color.cpp \
+    $(QUANTUM_PATH)/color.c \
+    $(QUANTUM_PATH)/led_tables.c
@@ -0,0 +1 @@
+TEST_LIST += color color_cie1931
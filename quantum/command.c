@@ -46,6 +46,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "audio.h"
 #endif /* AUDIO_ENABLE */
 
+#ifdef TASK_PROFILING_ENABLE
+#    include "task_profiling.h"
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
+#ifdef SPLIT_TELEMETRY_ENABLE
+#    include "split_telemetry.h"
+#endif
+
 static bool command_common(uint8_t code);
 static void command_common_help(void);
 static void print_version(void);
@@ -156,6 +168,18 @@ static void command_common_help(void) {
 #ifdef SLEEP_LED_ENABLE
         STR(MAGIC_KEY_SLEEP_LED) ":	Sleep LED Test\n"
 #endif
+
+#ifdef TASK_PROFILING_ENABLE
+        STR(MAGIC_KEY_PROFILING) ":	Print Task Profiling\n"
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+        STR(MAGIC_KEY_LATENCY_TRACE) ":	Print Latency Trace\n"
+#endif
+
+#ifdef SPLIT_TELEMETRY_ENABLE
+        STR(MAGIC_KEY_SPLIT_TELEMETRY) ":	Print Split Telemetry\n"
+#endif
     ); /* clang-format on */
 }
 
@@ -329,6 +353,30 @@ static bool command_common(uint8_t code) {
             break;
 #endif
 
+#ifdef TASK_PROFILING_ENABLE
+
+        // print main loop stage timings
+        case MAGIC_KC(MAGIC_KEY_PROFILING):
+            task_profiling_print();
+            break;
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+
+        // print key to report latencies
+        case MAGIC_KC(MAGIC_KEY_LATENCY_TRACE):
+            latency_trace_print();
+            break;
+#endif
+
+#ifdef SPLIT_TELEMETRY_ENABLE
+
+        // print split link counters
+        case MAGIC_KC(MAGIC_KEY_SPLIT_TELEMETRY):
+            split_telemetry_print();
+            break;
+#endif
+
         // print stored eeprom config
         case MAGIC_KC(MAGIC_KEY_EEPROM):
 #if !defined(NO_PRINT) && !defined(USER_PRINT)
@@ -158,5 +158,17 @@ bool command_proc(uint8_t code);
 
 #endif
 
+#ifndef MAGIC_KEY_PROFILING
+#    define MAGIC_KEY_PROFILING P
+#endif
+
+#ifndef MAGIC_KEY_LATENCY_TRACE
+#    define MAGIC_KEY_LATENCY_TRACE L
+#endif
+
+#ifndef MAGIC_KEY_SPLIT_TELEMETRY
+#    define MAGIC_KEY_SPLIT_TELEMETRY T
+#endif
+
 #define XMAGIC_KC(key) KC_##key
 #define MAGIC_KC(key) XMAGIC_KC(key)
@@ -0,0 +1,182 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Symmetric per-key algorithm with bit-sliced counters, behaving exactly like
+sym_defer_pk. Instead of an 8-bit counter per key, bit n of every counter in a
+row is kept together in one matrix_row_t. Counting down for a whole row is then
+a ripple-borrow subtraction over the DEBOUNCE_COUNTER_BITS planes, so the cost
+grows with the number of rows rather than with the number of keys.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+
+// Enough bits to hold DEBOUNCE
+#    if DEBOUNCE < 2
+#        define DEBOUNCE_COUNTER_BITS 1
+#    elif DEBOUNCE < 4
+#        define DEBOUNCE_COUNTER_BITS 2
+#    elif DEBOUNCE < 8
+#        define DEBOUNCE_COUNTER_BITS 3
+#    elif DEBOUNCE < 16
+#        define DEBOUNCE_COUNTER_BITS 4
+#    elif DEBOUNCE < 32
+#        define DEBOUNCE_COUNTER_BITS 5
+#    elif DEBOUNCE < 64
+#        define DEBOUNCE_COUNTER_BITS 6
+#    elif DEBOUNCE < 128
+#        define DEBOUNCE_COUNTER_BITS 7
+#    else
+#        define DEBOUNCE_COUNTER_BITS 8
+#    endif
+
+// counter_planes[bit][row] holds bit `bit` of the counter of every key in `row`
+static matrix_row_t counter_planes[DEBOUNCE_COUNTER_BITS][MATRIX_ROWS];
+// Keys with a non-zero counter
+static matrix_row_t counting[MATRIX_ROWS];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            counter_planes[bit][row] = 0;
+        }
+        counting[row] = 0;
+    }
+    counters_need_update = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+
+    // Any counter of DEBOUNCE or less expires once this much time has passed
+    if (elapsed_time >= DEBOUNCE) {
+        for (uint8_t row = 0; row < num_rows; row++) {
+            matrix_row_t expired = counting[row];
+            if (expired) {
+                matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+                cooked_changed |= cooked[row] ^ cooked_next;
+                cooked[row] = cooked_next;
+                for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+                    counter_planes[bit][row] = 0;
+                }
+                counting[row] = 0;
+            }
+        }
+        return;
+    }
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        if (!counting[row]) {
+            continue;
+        }
+
+        // counter -= elapsed_time, for every key in the row at once
+        matrix_row_t borrow    = 0;
+        matrix_row_t remaining = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            matrix_row_t plane = counter_planes[bit][row];
+            matrix_row_t diff;
+            if (elapsed_time & (1 << bit)) {
+                diff   = ~(plane ^ borrow);
+                borrow = ~plane | borrow;
+            } else {
+                diff   = plane ^ borrow;
+                borrow = ~plane & borrow;
+            }
+            counter_planes[bit][row] = diff;
+            remaining |= diff;
+        }
+
+        // Counters which reached zero or wrapped around have expired
+        matrix_row_t expired = counting[row] & (borrow | ~remaining);
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+
+        counting[row] &= ~expired;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            counter_planes[bit][row] &= counting[row];
+        }
+        if (counting[row]) {
+            counters_need_update = true;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta = raw[row] ^ cooked[row];
+        // Keys which changed back stop counting, newly changed keys start at DEBOUNCE
+        matrix_row_t starting = delta & ~counting[row];
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            matrix_row_t plane = counter_planes[bit][row] & delta;
+            if (DEBOUNCE & (1 << bit)) {
+                plane |= starting;
+            }
+            counter_planes[bit][row] = plane;
+        }
+        counting[row] = delta;
+        if (starting) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
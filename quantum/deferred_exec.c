@@ -12,31 +12,120 @@
 //------------------------------------
 // Helpers
 //
+// Each table doubles as a binary min-heap ordered by trigger time. Entries never move: heap position `i` refers to the
+// entry at `table[i].heap_slot`, and each entry knows its own position in `heap_pos`. The heap_slot values form a
+// permutation of the table, with the active entries in the first `n` positions and the free entries after them, so the
+// next free entry is always `table[n].heap_slot`. Tokens encode the slot of their entry so they can be found directly.
+//
 
-static deferred_token current_token = 0;
+// Tokens are 8 bits, so only this many entries of a table can be addressed
+#define MAX_TABLE_COUNT 255
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
+static inline size_t usable_count(size_t table_count) {
+    return table_count > MAX_TABLE_COUNT ? MAX_TABLE_COUNT : table_count;
+}
+
+static inline deferred_executor_t *heap_entry(deferred_executor_t *table, uint8_t pos) {
+    return &table[table[pos].heap_slot];
+}
+
+static inline bool triggers_before(const deferred_executor_t *a, const deferred_executor_t *b) {
+    return ((int32_t)TIMER_DIFF_32(a->trigger_time, b->trigger_time)) < 0;
+}
+
+static inline void heap_init_if_needed(deferred_executor_t *table, size_t table_count) {
+    // Zero-initialised tables have every position pointing at the first entry
+    if (table_count > 1 && table[0].heap_slot == table[table_count - 1].heap_slot) {
+        for (uint8_t i = 0; i < table_count; ++i) {
+            table[i].heap_slot = i;
+            table[i].heap_pos  = i;
+        }
     }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
+}
+
+static inline uint8_t heap_size(deferred_executor_t *table, size_t table_count) {
+    // Active entries form a prefix of the heap, so the boundary can be found by bisection
+    size_t lo = 0, hi = table_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (heap_entry(table, mid)->token != INVALID_DEFERRED_TOKEN) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
-    return true;
+    return lo;
+}
+
+static inline void heap_swap(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    uint8_t slot_a     = table[a].heap_slot;
+    uint8_t slot_b     = table[b].heap_slot;
+    table[a].heap_slot = slot_b;
+    table[b].heap_slot = slot_a;
+    table[slot_a].heap_pos = b;
+    table[slot_b].heap_pos = a;
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
+static void heap_fix(deferred_executor_t *table, uint8_t n, uint8_t pos) {
+    // Sift up
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!triggers_before(heap_entry(table, pos), heap_entry(table, parent))) {
+            break;
         }
+        heap_swap(table, pos, parent);
+        pos = parent;
+    }
+
+    // Sift down
+    while (true) {
+        uint8_t smallest = pos;
+        uint8_t left     = 2 * pos + 1;
+        uint8_t right    = left + 1;
+        if (left < n && triggers_before(heap_entry(table, left), heap_entry(table, smallest))) {
+            smallest = left;
+        }
+        if (right < n && triggers_before(heap_entry(table, right), heap_entry(table, smallest))) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            break;
+        }
+        heap_swap(table, pos, smallest);
+        pos = smallest;
     }
-    return current_token;
+}
+
+static void heap_remove(deferred_executor_t *table, uint8_t n, deferred_executor_t *entry) {
+    // Move the entry to the end of the heap, where it becomes the first free entry
+    uint8_t pos  = entry->heap_pos;
+    uint8_t last = n - 1;
+    heap_swap(table, pos, last);
+
+    entry->token        = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
+
+    if (pos < last) {
+        heap_fix(table, last, pos);
+    }
+}
+
+static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count, uint8_t slot) {
+    // Cycle through every token value mapping to this slot, to make stale tokens unlikely to match
+    deferred_executor_t *entry = &table[slot];
+    if (slot + 1 + (entry->generation + 1) * table_count > UINT8_MAX) {
+        entry->generation = 0;
+    } else {
+        entry->generation++;
+    }
+    return slot + 1 + entry->generation * table_count;
+}
+
+static inline deferred_executor_t *find_token(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    deferred_executor_t *entry = &table[(token - 1) % table_count];
+    return entry->token == token ? entry : NULL;
 }
 
 //------------------------------------
@@ -49,27 +138,24 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
+    table_count = usable_count(table_count);
+    heap_init_if_needed(table, table_count);
 
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // Claim the first free entry, if any
+    uint8_t n = heap_size(table, table_count);
+    if (n == table_count) {
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry
+    uint8_t              slot  = table[n].heap_slot;
+    deferred_executor_t *entry = &table[slot];
+    entry->token               = allocate_token(table, table_count, slot);
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+    heap_fix(table, n + 1, n);
+    return entry->token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -78,18 +164,16 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
         return false;
     }
 
-    // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    table_count                = usable_count(table_count);
+    deferred_executor_t *entry = find_token(table, table_count, token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    entry->trigger_time = timer_read32() + delay_ms;
+    heap_fix(table, heap_size(table, table_count), entry->heap_pos);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -98,21 +182,30 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
         return false;
     }
 
-    // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    table_count                = usable_count(table_count);
+    deferred_executor_t *entry = find_token(table, table_count, token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    heap_remove(table, heap_size(table, table_count), entry);
+    return true;
+}
+
+uint32_t deferred_exec_advanced_time_until_next(deferred_executor_t *table, size_t table_count) {
+    if (!table || table_count == 0) {
+        return DEFERRED_EXEC_NO_DEADLINE;
+    }
+
+    // The first entry of the heap is always the next one due
+    deferred_executor_t *entry = heap_entry(table, 0);
+    if (entry->token == INVALID_DEFERRED_TOKEN) {
+        return DEFERRED_EXEC_NO_DEADLINE;
+    }
+
+    int32_t remaining = (int32_t)TIMER_DIFF_32(entry->trigger_time, timer_read32());
+    return remaining > 0 ? (uint32_t)remaining : 0;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,35 +215,39 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
+        table_count = usable_count(table_count);
+
+        // Run the executors in order of their trigger time. Each pass runs at most table_count callbacks, so that
+        // catching up on a repeating executor which fell behind can't stall the main loop.
+        for (size_t budget = table_count; budget > 0; --budget) {
+            deferred_executor_t *entry      = heap_entry(table, 0);
             deferred_token       curr_token = entry->token;
 
-            // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
-
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
-                }
-
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
-                }
+            // Check if we're supposed to execute the next entry
+            if (curr_token == INVALID_DEFERRED_TOKEN || ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                break;
+            }
+
+            // Invoke the callback and work work out if we should be requeued
+            uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+            // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
+            if (entry->token != curr_token) {
+                continue;
+            }
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            uint8_t n = heap_size(table, table_count);
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                entry->trigger_time += delay_ms;
+                heap_fix(table, n, entry->heap_pos);
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                heap_remove(table, n, entry);
             }
         }
     }
@@ -172,6 +269,9 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
 bool cancel_deferred_exec(deferred_token token) {
     return cancel_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token);
 }
+uint32_t deferred_exec_time_until_next(void) {
+    return deferred_exec_advanced_time_until_next(basic_executors, MAX_DEFERRED_EXECUTORS);
+}
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
@@ -21,6 +21,11 @@ typedef uint8_t deferred_token;
  */
 #define INVALID_DEFERRED_TOKEN 0
 
+/**
+ * @def The value returned when no deferred execution is pending.
+ */
+#define DEFERRED_EXEC_NO_DEADLINE UINT32_MAX
+
 /**
  * @typedef Callback to execute.
  * @param trigger_time[in] the intended trigger time to execute the callback -- equivalent time-space as timer_read32()
@@ -60,6 +65,13 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms);
  */
 bool cancel_deferred_exec(deferred_token token);
 
+/**
+ * Gets the time until the next deferred execution is due.
+ *
+ * @return the number of milliseconds until the next callback is due, zero if one is already due, or DEFERRED_EXEC_NO_DEADLINE if none are pending
+ */
+uint32_t deferred_exec_time_until_next(void);
+
 /**
  * Forward declaration for the main loop in order to execute any deferred executors. Should not be invoked by keyboard/user code.
  */
@@ -76,6 +88,9 @@ void deferred_exec_task(void);
  */
 typedef struct deferred_executor_t {
     deferred_token         token;
+    uint8_t                generation;
+    uint8_t                heap_pos;
+    uint8_t                heap_slot;
     uint32_t               trigger_time;
     deferred_exec_callback callback;
     void *                 cb_arg;
@@ -110,6 +125,15 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  */
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token);
 
+/**
+ * Gets the time until the next deferred execution in a custom table is due.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @return the number of milliseconds until the next callback is due, zero if one is already due, or DEFERRED_EXEC_NO_DEADLINE if none are pending
+ */
+uint32_t deferred_exec_advanced_time_until_next(deferred_executor_t *table, size_t table_count);
+
 /**
  * Forward declaration for the main loop in order to execute any custom table deferred executors. Should not be invoked by keyboard/user code.
  * Needed for any custom-allocated deferred execution tables. Any core tasks should add appropriate invocation to quantum/main.c.
@@ -0,0 +1,247 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#define TABLE_COUNT 6
+
+struct Call {
+    int      id;
+    uint32_t trigger_time;
+};
+
+static std::vector<Call> calls;
+static uint32_t          repeat_ms;
+
+static uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    calls.push_back({(int)(intptr_t)cb_arg, trigger_time});
+    return 0;
+}
+
+static uint32_t repeat_callback(uint32_t trigger_time, void *cb_arg) {
+    calls.push_back({(int)(intptr_t)cb_arg, trigger_time});
+    return repeat_ms;
+}
+
+class DeferredExecTest : public ::testing::Test {
+   protected:
+    deferred_executor_t table[TABLE_COUNT] = {};
+    uint32_t            last_exec          = 0;
+
+    void SetUp() override {
+        timer_clear();
+        calls.clear();
+        repeat_ms = 0;
+    }
+
+    deferred_token defer(uint32_t delay_ms, int id, deferred_exec_callback callback = record_callback) {
+        return defer_exec_advanced(table, TABLE_COUNT, delay_ms, callback, (void *)(intptr_t)id);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_advanced_task(table, TABLE_COUNT, &last_exec);
+        }
+    }
+
+    std::vector<int> ids() {
+        std::vector<int> result;
+        for (auto &call : calls) {
+            result.push_back(call.id);
+        }
+        return result;
+    }
+};
+
+TEST_F(DeferredExecTest, RunsInTriggerOrder) {
+    defer(30, 3);
+    defer(10, 1);
+    defer(50, 5);
+    defer(20, 2);
+    defer(40, 4);
+
+    run_for(100);
+    EXPECT_EQ(ids(), std::vector<int>({1, 2, 3, 4, 5}));
+    EXPECT_EQ(calls[0].trigger_time, 10);
+    EXPECT_EQ(calls[4].trigger_time, 50);
+}
+
+TEST_F(DeferredExecTest, DoesNotRunEarly) {
+    defer(10, 1);
+    run_for(9);
+    EXPECT_TRUE(calls.empty());
+    run_for(1);
+    EXPECT_EQ(ids(), std::vector<int>({1}));
+}
+
+TEST_F(DeferredExecTest, RejectsInvalidRequests) {
+    EXPECT_EQ(defer(0, 1), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec_advanced(table, TABLE_COUNT, 10, NULL, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_COUNT, INVALID_DEFERRED_TOKEN));
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TABLE_COUNT, 1, 10));
+}
+
+TEST_F(DeferredExecTest, FullTableRejectsNewEntries) {
+    std::vector<deferred_token> tokens;
+    for (int i = 0; i < TABLE_COUNT; i++) {
+        deferred_token token = defer(10 + i, i);
+        EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+        for (auto other : tokens) {
+            EXPECT_NE(token, other);
+        }
+        tokens.push_back(token);
+    }
+    EXPECT_EQ(defer(10, 99), INVALID_DEFERRED_TOKEN);
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_COUNT, tokens[2]));
+    EXPECT_NE(defer(10, 99), INVALID_DEFERRED_TOKEN);
+}
+
+TEST_F(DeferredExecTest, CancelRemovesOnlyThatEntry) {
+    defer(10, 1);
+    deferred_token token = defer(20, 2);
+    defer(30, 3);
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_COUNT, token));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_COUNT, token));
+
+    run_for(100);
+    EXPECT_EQ(ids(), std::vector<int>({1, 3}));
+}
+
+TEST_F(DeferredExecTest, StaleTokenDoesNotMatchReusedEntry) {
+    deferred_token stale = defer(10, 1);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_COUNT, stale));
+
+    deferred_token fresh = defer(10, 2);
+    EXPECT_NE(fresh, stale);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_COUNT, stale));
+
+    run_for(20);
+    EXPECT_EQ(ids(), std::vector<int>({2}));
+}
+
+TEST_F(DeferredExecTest, ExtendReordersEntries) {
+    deferred_token token = defer(10, 1);
+    defer(20, 2);
+
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_COUNT, token, 30));
+    run_for(100);
+    EXPECT_EQ(ids(), std::vector<int>({2, 1}));
+    EXPECT_EQ(calls[1].trigger_time, 30);
+}
+
+TEST_F(DeferredExecTest, RepeatsRelativeToPreviousTrigger) {
+    repeat_ms = 10;
+    defer(10, 1, repeat_callback);
+    defer(25, 2);
+
+    run_for(40);
+    EXPECT_EQ(ids(), std::vector<int>({1, 1, 2, 1, 1}));
+    EXPECT_EQ(calls[1].trigger_time, 20);
+    EXPECT_EQ(calls[4].trigger_time, 40);
+}
+
+TEST_F(DeferredExecTest, ReportsTimeUntilNextDeadline) {
+    EXPECT_EQ(deferred_exec_advanced_time_until_next(table, TABLE_COUNT), DEFERRED_EXEC_NO_DEADLINE);
+
+    deferred_token token = defer(50, 1);
+    defer(80, 2);
+    EXPECT_EQ(deferred_exec_advanced_time_until_next(table, TABLE_COUNT), 50);
+
+    set_time(20);
+    EXPECT_EQ(deferred_exec_advanced_time_until_next(table, TABLE_COUNT), 30);
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_COUNT, token));
+    EXPECT_EQ(deferred_exec_advanced_time_until_next(table, TABLE_COUNT), 60);
+
+    set_time(100);
+    EXPECT_EQ(deferred_exec_advanced_time_until_next(table, TABLE_COUNT), 0);
+}
+
+static deferred_executor_t *requeue_table;
+static uint32_t             requeue_callback(uint32_t trigger_time, void *cb_arg) {
+    calls.push_back({(int)(intptr_t)cb_arg, trigger_time});
+    if ((intptr_t)cb_arg == 1) {
+        // Replace ourselves with a different executor
+        defer_exec_advanced(requeue_table, TABLE_COUNT, 5, requeue_callback, (void *)(intptr_t)2);
+    }
+    return 0;
+}
+
+TEST_F(DeferredExecTest, CallbackCanQueueNewEntries) {
+    requeue_table = table;
+    defer(10, 1, requeue_callback);
+
+    run_for(20);
+    EXPECT_EQ(ids(), std::vector<int>({1, 2}));
+    EXPECT_EQ(calls[1].trigger_time, 15);
+}
+
+TEST_F(DeferredExecTest, CatchUpIsSpreadOverPasses) {
+    repeat_ms = 1;
+    defer(1, 1, repeat_callback);
+
+    // Only the main loop is delayed, the executor is still due every millisecond
+    set_time(100);
+    deferred_exec_advanced_task(table, TABLE_COUNT, &last_exec);
+    EXPECT_EQ(calls.size(), TABLE_COUNT);
+}
+
+TEST_F(DeferredExecTest, RandomChurnKeepsOrdering) {
+    struct Pending {
+        deferred_token token;
+        uint32_t       trigger_time;
+        int            id;
+    };
+    std::vector<Pending> pending;
+    uint32_t             seed    = 12345;
+    int                  next_id = 0;
+
+    for (int round = 0; round < 2000; round++) {
+        seed         = seed * 1103515245 + 12345;
+        int op       = (seed >> 16) % 3;
+        int pick     = (seed >> 4) % TABLE_COUNT;
+        int delay_ms = 1 + ((seed >> 8) % 40);
+
+        if (op == 0 && pending.size() < TABLE_COUNT) {
+            deferred_token token = defer(delay_ms, next_id);
+            ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+            pending.push_back({token, timer_read32() + delay_ms, next_id++});
+        } else if (op == 1 && pick < (int)pending.size()) {
+            EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_COUNT, pending[pick].token));
+            pending.erase(pending.begin() + pick);
+        } else if (op == 2 && pick < (int)pending.size()) {
+            EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_COUNT, pending[pick].token, delay_ms));
+            pending[pick].trigger_time = timer_read32() + delay_ms;
+        }
+
+        run_for(1);
+
+        // Everything that was due ran, in trigger order, at its trigger time
+        uint32_t previous = 0;
+        for (auto &call : calls) {
+            auto it = std::find_if(pending.begin(), pending.end(), [&](const Pending &p) { return p.id == call.id; });
+            ASSERT_NE(it, pending.end());
+            EXPECT_EQ(call.trigger_time, it->trigger_time);
+            EXPECT_GE(call.trigger_time, previous);
+            previous = call.trigger_time;
+            pending.erase(it);
+        }
+        for (auto &p : pending) {
+            EXPECT_GT(p.trigger_time, timer_read32());
+        }
+        calls.clear();
+    }
+}
@@ -0,0 +1,6 @@
+deferred_exec_DEFS := -DDEFERRED_EXEC_ENABLE
+
+deferred_exec_SRC := \
+    $(QUANTUM_PATH)/deferred_exec/tests/deferred_exec.cpp \
+    $(QUANTUM_PATH)/deferred_exec.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
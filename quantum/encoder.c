@@ -98,6 +98,19 @@ bool encoder_queue_empty(void) {
     return encoder_queue_empty_advanced(&encoder_events);
 }
 
+uint32_t encoder_time_until_next(void) {
+    if (!encoder_queue_empty()) {
+        return 0;
+    }
+#ifdef TICKLESS_IDLE_ENCODER_WAKEUP
+    // The keyboard wakes the main loop on encoder pin changes
+    return UINT32_MAX;
+#else
+    // The pins are sampled, so every pass is needed to see each quadrature step
+    return 0;
+#endif
+}
+
 bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise) {
     // Drop out if we're full
     if (encoder_queue_full_advanced(events)) {
@@ -28,6 +28,8 @@ __attribute__((weak)) bool should_process_encoder(void);
 
 void encoder_init(void);
 bool encoder_task(void);
+// Time until encoder_task() next needs to run, or UINT32_MAX if nothing is pending
+uint32_t encoder_time_until_next(void);
 bool encoder_queue_event(uint8_t index, bool clockwise);
 bool encoder_dequeue_event(uint8_t *index, bool *clockwise);
 
@@ -113,6 +113,17 @@ void haptic_task(void) {
 #endif // HAPTIC_SOLENOID
 }
 
+uint32_t haptic_time_until_next(void) {
+#ifdef HAPTIC_SOLENOID
+#    if defined(SPLIT_KEYBOARD) && !defined(SPLIT_HAPTIC_ENABLE)
+    if (!is_keyboard_master()) return UINT32_MAX;
+#    endif
+    return solenoid_time_until_next();
+#else
+    return UINT32_MAX;
+#endif // HAPTIC_SOLENOID
+}
+
 void eeconfig_debug_haptic(void) {
     dprintf("haptic_config eeprom\n");
     dprintf("haptic_config.enable = %d\n", haptic_config.enable);
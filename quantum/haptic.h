@@ -53,6 +53,7 @@ typedef enum HAPTIC_FEEDBACK {
 
 void    haptic_init(void);
 void    haptic_task(void);
+uint32_t haptic_time_until_next(void);
 void    eeconfig_debug_haptic(void);
 void    haptic_enable(void);
 void    haptic_disable(void);
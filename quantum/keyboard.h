@@ -74,13 +74,20 @@ static inline bool IS_DIPSWITCHEVENT(const keyevent_t event) {
 #define MAKE_KEYPOS(row_num, col_num) ((keypos_t){.row = (row_num), .col = (col_num)})
 
 /* Common keyevent_t object factory */
-#define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type)})
+#define MAKE_TIMED_EVENT(row_num, col_num, press, event_type, event_time) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = (event_time), .type = (event_type)})
+#define MAKE_EVENT(row_num, col_num, press, event_type) MAKE_TIMED_EVENT((row_num), (col_num), (press), (event_type), timer_read())
 
 /**
  * @brief Constructs a key event for a pressed or released key.
  */
 #define MAKE_KEYEVENT(row_num, col_num, press) MAKE_EVENT((row_num), (col_num), (press), KEY_EVENT)
 
+/**
+ * @brief Constructs a key event for a pressed or released key, stamped with
+ * the time at which the switch change was captured.
+ */
+#define MAKE_TIMED_KEYEVENT(row_num, col_num, press, event_time) MAKE_TIMED_EVENT((row_num), (col_num), (press), KEY_EVENT, (event_time))
+
 /**
  * @brief Constructs a combo event.
  */
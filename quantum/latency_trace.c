@@ -0,0 +1,252 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "latency_trace.h"
+
+#include <string.h>
+#include "timer.h"
+#include "keycode.h"
+#include "keycodes.h"
+#include "quantum_keycodes.h"
+#include "print.h"
+
+#define LATENCY_TRACE_UNSET 0
+#define LATENCY_TRACE_COMBO 1    // left the combo buffer as itself
+#define LATENCY_TRACE_CONSUMED 2 // became part of a combo's own event
+#define LATENCY_TRACE_TAPPING 3
+#define LATENCY_TRACE_PROCESSED 4
+
+typedef struct {
+    latency_trace_t trace;
+    uint16_t        stage_time;    // when the current stage was entered
+    uint16_t        combo_keycode; // keycode of the combo which consumed the key
+    uint8_t         code;          // key expected in the report, or KC_NO
+    uint8_t         mods;          // modifiers expected in the report
+    uint8_t         state;
+    bool            active;
+} latency_trace_pending_t;
+
+static latency_trace_pending_t pending[LATENCY_TRACE_PENDING_SIZE];
+
+static latency_trace_t traces[LATENCY_TRACE_BUFFER_SIZE];
+static uint8_t         traces_head = 0;
+static uint8_t         traces_tail = 0;
+
+static void traces_enqueue(const latency_trace_t *trace) {
+    uint8_t next = (traces_head + 1) % LATENCY_TRACE_BUFFER_SIZE;
+    if (next == traces_tail) {
+        // Full, drop the oldest
+        traces_tail = (traces_tail + 1) % LATENCY_TRACE_BUFFER_SIZE;
+    }
+    traces[traces_head] = *trace;
+    traces_head         = next;
+}
+
+bool latency_trace_read(latency_trace_t *trace) {
+    if (traces_head == traces_tail) {
+        return false;
+    }
+    *trace      = traces[traces_tail];
+    traces_tail = (traces_tail + 1) % LATENCY_TRACE_BUFFER_SIZE;
+    return true;
+}
+
+static latency_trace_pending_t *pending_find(keyevent_t event) {
+    for (uint8_t i = 0; i < LATENCY_TRACE_PENDING_SIZE; i++) {
+        if (pending[i].active && pending[i].state != LATENCY_TRACE_CONSUMED && pending[i].trace.pressed == event.pressed && KEYEQ(pending[i].trace.key, event.key)) {
+            return &pending[i];
+        }
+    }
+    return NULL;
+}
+
+void latency_trace_key_edge(keyevent_t event) {
+    const uint16_t           now  = timer_read();
+    latency_trace_pending_t *slot = pending_find(event);
+
+    if (!slot) {
+        // Prefer a free slot, otherwise evict the oldest trace
+        for (uint8_t i = 0; i < LATENCY_TRACE_PENDING_SIZE; i++) {
+            if (!pending[i].active) {
+                slot = &pending[i];
+                break;
+            }
+            if (!slot || TIMER_DIFF_16(now, pending[i].trace.edge_time) > TIMER_DIFF_16(now, slot->trace.edge_time)) {
+                slot = &pending[i];
+            }
+        }
+    }
+
+    memset(slot, 0, sizeof(latency_trace_pending_t));
+    slot->trace.key       = event.key;
+    slot->trace.pressed   = event.pressed;
+    slot->trace.edge_time = now;
+    slot->stage_time      = now;
+    slot->active          = true;
+}
+
+static void pending_leave_combo(latency_trace_pending_t *entry, uint16_t now) {
+    entry->trace.combo_time = TIMER_DIFF_16(now, entry->stage_time);
+    entry->stage_time       = now;
+}
+
+void latency_trace_combo_released(keyevent_t event) {
+    latency_trace_pending_t *entry = pending_find(event);
+    if (!entry || entry->state != LATENCY_TRACE_UNSET) {
+        return;
+    }
+
+    pending_leave_combo(entry, timer_read());
+    entry->state = LATENCY_TRACE_COMBO;
+}
+
+void latency_trace_combo_consumed(keyevent_t event, uint16_t combo_keycode) {
+    latency_trace_pending_t *entry = pending_find(event);
+    if (!entry || entry->state != LATENCY_TRACE_UNSET) {
+        return;
+    }
+
+    if (combo_keycode == KC_NO) {
+        // Handled by process_combo_event(), there is no event to follow
+        pending_leave_combo(entry, timer_read());
+        entry->state = LATENCY_TRACE_PROCESSED;
+    } else {
+        // A release stays held by the combo until the combo itself is released
+        if (event.pressed) {
+            pending_leave_combo(entry, timer_read());
+        }
+        entry->combo_keycode = combo_keycode;
+        entry->state         = LATENCY_TRACE_CONSUMED;
+    }
+}
+
+void latency_trace_tapping_enter(keyevent_t event) {
+    latency_trace_pending_t *entry = pending_find(event);
+    if (!entry) {
+        return;
+    }
+
+    if (entry->state == LATENCY_TRACE_UNSET) {
+        // Not a combo key, or combos are disabled
+        pending_leave_combo(entry, timer_read());
+    } else if (entry->state != LATENCY_TRACE_COMBO) {
+        return;
+    }
+    entry->state = LATENCY_TRACE_TAPPING;
+}
+
+static void pending_processed(latency_trace_pending_t *entry, uint16_t keycode, keyrecord_t *record, uint16_t now) {
+    if (entry->state == LATENCY_TRACE_UNSET || (entry->state == LATENCY_TRACE_CONSUMED && !entry->trace.pressed)) {
+        // Never went through combos or tapping, or released with the combo
+        pending_leave_combo(entry, now);
+    } else {
+        entry->trace.tapping_time = TIMER_DIFF_16(now, entry->stage_time);
+        entry->stage_time         = now;
+    }
+    entry->state = LATENCY_TRACE_PROCESSED;
+
+    // Work out what the report will carry once the keycode takes effect
+    if (IS_QK_MODS(keycode)) {
+        keycode = QK_MODS_GET_BASIC_KEYCODE(keycode);
+    } else if (IS_QK_MOD_TAP(keycode)) {
+#ifndef NO_ACTION_TAPPING
+        if (record->tap.count) {
+            keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+        } else
+#endif
+        {
+            // 5-bit packed modifiers to the 8-bit report format
+            uint8_t mods = QK_MOD_TAP_GET_MODS(keycode);
+            entry->mods  = (mods & 0x10) ? (mods & 0x0F) << 4 : mods;
+            keycode      = KC_NO;
+        }
+    }
+
+    if (IS_BASIC_KEYCODE(keycode)) {
+        entry->code = keycode;
+    } else if (IS_MODIFIER_KEYCODE(keycode)) {
+        entry->mods = MOD_BIT(keycode);
+    }
+}
+
+void latency_trace_record_processed(uint16_t keycode, keyrecord_t *record) {
+    const uint16_t now = timer_read();
+
+    if (IS_COMBOEVENT(record->event)) {
+        // Follow every key the combo consumed as the combo's event
+        for (uint8_t i = 0; i < LATENCY_TRACE_PENDING_SIZE; i++) {
+            if (pending[i].active && pending[i].state == LATENCY_TRACE_CONSUMED && pending[i].trace.pressed == record->event.pressed && pending[i].combo_keycode == keycode) {
+                pending_processed(&pending[i], keycode, record, now);
+            }
+        }
+        return;
+    }
+
+    latency_trace_pending_t *entry = pending_find(record->event);
+    if (entry && entry->state != LATENCY_TRACE_PROCESSED) {
+        pending_processed(entry, keycode, record, now);
+    }
+}
+
+static bool pending_carried(const latency_trace_pending_t *entry, uint8_t mods, bool code_down) {
+    if (entry->code == KC_NO && entry->mods == 0) {
+        // Nothing to look for, the first report completes it
+        return true;
+    }
+    if (entry->trace.pressed) {
+        return (entry->code == KC_NO || code_down) && (mods & entry->mods) == entry->mods;
+    }
+    return (entry->code == KC_NO || !code_down) && (mods & entry->mods) == 0;
+}
+
+static void pending_complete(latency_trace_pending_t *entry, uint16_t now) {
+    entry->trace.deferred_time = TIMER_DIFF_16(now, entry->stage_time);
+    traces_enqueue(&entry->trace);
+    entry->active = false;
+}
+
+void latency_trace_keyboard_report_sent(const report_keyboard_t *report) {
+    const uint16_t now = timer_read();
+
+    for (uint8_t i = 0; i < LATENCY_TRACE_PENDING_SIZE; i++) {
+        if (!pending[i].active || pending[i].state != LATENCY_TRACE_PROCESSED) {
+            continue;
+        }
+        bool code_down = false;
+        for (uint8_t k = 0; pending[i].code != KC_NO && k < KEYBOARD_REPORT_KEYS; k++) {
+            code_down |= report->keys[k] == pending[i].code;
+        }
+        if (pending_carried(&pending[i], report->mods, code_down)) {
+            pending_complete(&pending[i], now);
+        }
+    }
+}
+
+void latency_trace_nkro_report_sent(const report_nkro_t *report) {
+    const uint16_t now = timer_read();
+
+    for (uint8_t i = 0; i < LATENCY_TRACE_PENDING_SIZE; i++) {
+        if (!pending[i].active || pending[i].state != LATENCY_TRACE_PROCESSED) {
+            continue;
+        }
+        const uint8_t code      = pending[i].code;
+        bool          code_down = (code >> 3) < NKRO_REPORT_BITS && (report->bits[code >> 3] & (1 << (code & 7)));
+        if (pending_carried(&pending[i], report->mods, code_down)) {
+            pending_complete(&pending[i], now);
+        }
+    }
+}
+
+void latency_trace_clear(void) {
+    memset(pending, 0, sizeof(pending));
+    traces_head = traces_tail = 0;
+}
+
+void latency_trace_print(void) {
+    latency_trace_t trace;
+
+    xprintf("\n\t- Latency trace (ms) -\n");
+    while (latency_trace_read(&trace)) {
+        xprintf("%02u:%02u %s total=%u combo=%u tapping=%u deferred=%u\n", trace.key.row, trace.key.col, trace.pressed ? "down" : "up  ", latency_trace_total(&trace), trace.combo_time, trace.tapping_time, trace.deferred_time);
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+#include "action.h"
+#include "report.h"
+
+/*
+    Key-to-report latency tracing.
+
+    Every debounced key edge seen by matrix_task() is followed through the
+    action pipeline until the keyboard report which carries it is handed to
+    the host driver. The time between the two is split into the stages which
+    can hold an event back:
+
+        matrix_task()             edge
+                                    │  combo_time
+        process_combo()           released from (or consumed by) the combo buffer
+                                    │  tapping_time
+        process_record_quantum()  processed
+                                    │  deferred_time
+        host_*_send()             report carrying the key
+
+    A key consumed by a combo is followed as the combo's own event from then
+    on. Keys which do not map to a keycode or modifier in the report, such as
+    layer keys, complete on the first report after they were processed.
+
+    Completed traces are kept in a small ring buffer for later inspection.
+*/
+
+#ifndef LATENCY_TRACE_BUFFER_SIZE
+#    define LATENCY_TRACE_BUFFER_SIZE 16
+#endif
+
+#ifndef LATENCY_TRACE_PENDING_SIZE
+#    define LATENCY_TRACE_PENDING_SIZE 8
+#endif
+
+typedef struct {
+    keypos_t key;
+    bool     pressed;
+    uint16_t edge_time;     // when the debounced edge was seen by matrix_task()
+    uint16_t combo_time;    // held back by combo processing
+    uint16_t tapping_time;  // held back by the tapping and waiting buffers
+    uint16_t deferred_time; // from processing until the report carrying it was sent
+} latency_trace_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Total time from the debounced edge until the report was sent.
+ */
+static inline uint16_t latency_trace_total(const latency_trace_t *trace) {
+    return trace->combo_time + trace->tapping_time + trace->deferred_time;
+}
+
+/* pipeline hooks */
+void latency_trace_key_edge(keyevent_t event);
+void latency_trace_combo_released(keyevent_t event);
+void latency_trace_combo_consumed(keyevent_t event, uint16_t combo_keycode);
+void latency_trace_tapping_enter(keyevent_t event);
+void latency_trace_record_processed(uint16_t keycode, keyrecord_t *record);
+void latency_trace_keyboard_report_sent(const report_keyboard_t *report);
+void latency_trace_nkro_report_sent(const report_nkro_t *report);
+
+/**
+ * @brief Pop the oldest completed trace.
+ *
+ * @return false if no traces are available
+ */
+bool latency_trace_read(latency_trace_t *trace);
+
+/**
+ * @brief Discard all pending and completed traces.
+ */
+void latency_trace_clear(void);
+
+/**
+ * @brief Print and discard all completed traces.
+ */
+void latency_trace_print(void);
+
+#ifdef __cplusplus
+}
+#endif
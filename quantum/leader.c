@@ -43,6 +43,19 @@ void leader_task(void) {
     }
 }
 
+uint32_t leader_time_until_next(void) {
+#if defined(LEADER_NO_TIMEOUT)
+    if (!leading || leader_sequence_size == 0) {
+#else
+    if (!leading) {
+#endif
+        return UINT32_MAX;
+    }
+
+    uint16_t elapsed = timer_elapsed(leader_time);
+    return elapsed <= LEADER_TIMEOUT ? LEADER_TIMEOUT - elapsed + 1 : 0;
+}
+
 bool leader_sequence_active(void) {
     return leading;
 }
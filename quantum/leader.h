@@ -33,6 +33,11 @@ void leader_end(void);
 
 void leader_task(void);
 
+/**
+ * Time until the leader sequence times out, or UINT32_MAX if it can't.
+ */
+uint32_t leader_time_until_next(void);
+
 /**
  * Whether the leader sequence is active.
  */
@@ -315,9 +315,7 @@ static void led_task_flush(uint8_t effect) {
     led_task_state = SYNCING;
 }
 
-void led_matrix_task(void) {
-    led_task_timers();
-
+static uint8_t led_task_effect(void) {
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -326,7 +324,13 @@ void led_matrix_task(void) {
 #endif // LED_MATRIX_TIMEOUT > 0
                              false;
 
-    uint8_t effect = suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
+    return suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
+}
+
+void led_matrix_task(void) {
+    led_task_timers();
+
+    uint8_t effect = led_task_effect();
 
     switch (led_task_state) {
         case STARTING:
@@ -350,6 +354,22 @@ void led_matrix_task(void) {
     }
 }
 
+uint32_t led_matrix_time_until_next(void) {
+    if (led_task_state != SYNCING) {
+        // Part way through a frame
+        return 0;
+    }
+
+    uint8_t effect = led_task_effect();
+    if (effect == LED_MATRIX_NONE && led_last_effect == LED_MATRIX_NONE && led_matrix_eeconfig.enable == led_last_enable) {
+        // Nothing new to render
+        return UINT32_MAX;
+    }
+
+    uint32_t elapsed = sync_timer_elapsed32(g_led_timer);
+    return elapsed < LED_MATRIX_LED_FLUSH_LIMIT ? LED_MATRIX_LED_FLUSH_LIMIT - elapsed : 0;
+}
+
 void led_matrix_indicators(void) {
     led_matrix_indicators_kb();
 }
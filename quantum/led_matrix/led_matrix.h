@@ -128,6 +128,9 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void led_matrix_task(void);
 
+// Time until led_matrix_task() next has a frame to render, or UINT32_MAX if nothing is pending
+uint32_t led_matrix_time_until_next(void);
+
 // This runs after another backlight effect and replaces
 // values already set
 void led_matrix_indicators(void);
@@ -72,5 +72,11 @@ int main(void) {
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef TICKLESS_IDLE_ENABLE
+        // Sleep until something is due
+        void tickless_idle_task(void);
+        tickless_idle_task();
+#endif // TICKLESS_IDLE_ENABLE
     }
 }
@@ -51,6 +51,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define MATRIX_INPUT_PRESSED_STATE 0
 #endif
 
+#if defined(MATRIX_EVENT_DRIVEN_SCAN) && (defined(DIRECT_PINS) || !defined(MATRIX_ROW_PINS) || !defined(MATRIX_COL_PINS))
+#    error MATRIX_EVENT_DRIVEN_SCAN requires a COL2ROW or ROW2COL diode matrix
+#endif
+
 #ifdef DIRECT_PINS
 static SPLIT_MUTABLE pin_t direct_pins[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS;
 #elif (DIODE_DIRECTION == ROW2COL) || (DIODE_DIRECTION == COL2ROW)
@@ -163,6 +167,27 @@ static void unselect_rows(void) {
     }
 }
 
+#            ifdef MATRIX_EVENT_DRIVEN_SCAN
+static void select_all_lines(void) {
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        select_row(x);
+    }
+}
+
+static void unselect_all_lines(void) {
+    unselect_rows();
+}
+
+static bool any_input_active(void) {
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        if (readMatrixPin(col_pins[x]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+#            endif
+
 __attribute__((weak)) void matrix_init_pins(void) {
     unselect_rows();
     for (uint8_t x = 0; x < MATRIX_COLS; x++) {
@@ -226,6 +251,27 @@ static void unselect_cols(void) {
     }
 }
 
+#            ifdef MATRIX_EVENT_DRIVEN_SCAN
+static void select_all_lines(void) {
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        select_col(x);
+    }
+}
+
+static void unselect_all_lines(void) {
+    unselect_cols();
+}
+
+static bool any_input_active(void) {
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        if (readMatrixPin(row_pins[x]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+#            endif
+
 __attribute__((weak)) void matrix_init_pins(void) {
     unselect_cols();
     for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
@@ -320,30 +366,101 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
+#ifdef MATRIX_EVENT_DRIVEN_SCAN
+static bool matrix_idle_state = false;
+
+bool matrix_is_idle(void) {
+    return matrix_idle_state;
+}
+
+static bool matrix_rows_clear(const matrix_row_t rows[]) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (rows[row]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether a full scan is required while idle.
+ *
+ * When idle, every output line is left selected so that a single read of the
+ * input lines reveals whether any switch has been pressed. This is also the
+ * state in which the platform can arm pin-change interrupts on the inputs.
+ *
+ * @return true A switch is pressed and the matrix must be scanned
+ * @return false Still idle, the raw matrix is unchanged
+ */
+static bool matrix_idle_wake(void) {
+    if (!matrix_idle_state) {
+        return true;
+    }
+    if (!any_input_active()) {
+        return false;
+    }
+    unselect_all_lines();
+    matrix_output_unselect_delay(0, true);
+    matrix_idle_state = false;
+    return true;
+}
+
+static void matrix_idle_enter(matrix_row_t cooked[]) {
+    if (matrix_rows_clear(raw_matrix) && matrix_rows_clear(cooked)) {
+        select_all_lines();
+        matrix_idle_state = true;
+    }
+}
+#endif
+
 uint8_t matrix_scan(void) {
-    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
+    bool changed = false;
+
+#ifdef MATRIX_EVENT_DRIVEN_SCAN
+    if (matrix_idle_wake())
+#endif
+    {
+        matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
-    // Set row, read cols
-    for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
-        matrix_read_cols_on_row(curr_matrix, current_row);
-    }
+        // Set row, read cols
+        for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
+            matrix_read_cols_on_row(curr_matrix, current_row);
+        }
 #elif (DIODE_DIRECTION == ROW2COL)
-    // Set col, read rows
-    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
-    for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
-        matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
-    }
+        // Set col, read rows
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
+            matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
+        }
 #endif
 
-    bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
-    if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
+        changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
+        if (changed) {
+#ifdef MATRIX_KEY_TIMESTAMPS
+#    ifdef SPLIT_KEYBOARD
+            matrix_stamp_raw_changes(raw_matrix, curr_matrix, thisHand);
+#    else
+            matrix_stamp_raw_changes(raw_matrix, curr_matrix, 0);
+#    endif
+#endif
+            memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
+        }
+    }
 
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
+#endif
+
+#ifdef MATRIX_EVENT_DRIVEN_SCAN
+#    ifdef SPLIT_KEYBOARD
+    matrix_idle_enter(matrix + thisHand);
+#    else
+    matrix_idle_enter(matrix);
+#    endif
 #endif
     return (uint8_t)changed;
 }
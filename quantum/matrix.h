@@ -64,6 +64,17 @@ void matrix_output_select_delay(void);
 void matrix_output_unselect_delay(uint8_t line, bool key_pressed);
 /* only for backwards compatibility. delay between changing matrix pin state and reading values */
 void matrix_io_delay(void);
+/* whether all lines are selected while waiting for a press (MATRIX_EVENT_DRIVEN_SCAN) */
+bool matrix_is_idle(void);
+
+#ifdef MATRIX_KEY_TIMESTAMPS
+/* time at which the current state of a switch was captured */
+uint16_t matrix_get_key_time(uint8_t row, uint8_t col);
+/* record the capture time of every switch that differs between two scans of one half */
+void matrix_stamp_raw_changes(const matrix_row_t previous[], const matrix_row_t current[], uint8_t row_offset);
+/* set the capture time of a single switch, for changes timed elsewhere */
+void matrix_set_key_time(uint8_t row, uint8_t col, uint16_t time);
+#endif
 
 /* power control */
 void matrix_power_up(void);
@@ -1,5 +1,7 @@
+#include <string.h>
 #include "matrix.h"
 #include "debounce.h"
+#include "timer.h"
 #include "wait.h"
 #include "print.h"
 #include "debug.h"
@@ -7,7 +9,6 @@
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
-#    include <string.h>
 
 #    define ROWS_PER_HAND (MATRIX_ROWS / 2)
 #else
@@ -31,6 +32,10 @@ uint8_t thisHand, thatHand;
 extern const matrix_row_t matrix_mask[];
 #endif
 
+#ifdef MATRIX_KEY_TIMESTAMPS
+static uint16_t matrix_key_time[MATRIX_ROWS][MATRIX_COLS];
+#endif
+
 // user-defined overridable functions
 
 __attribute__((weak)) void matrix_init_kb(void) {
@@ -69,6 +74,38 @@ inline matrix_row_t matrix_get_row(uint8_t row) {
 #endif
 }
 
+#ifdef MATRIX_KEY_TIMESTAMPS
+uint16_t matrix_get_key_time(uint8_t row, uint8_t col) {
+    return matrix_key_time[row][col];
+}
+
+void matrix_set_key_time(uint8_t row, uint8_t col, uint16_t time) {
+    matrix_key_time[row][col] = time;
+}
+
+static void matrix_set_key_times(uint8_t row, matrix_row_t changes, uint16_t time) {
+    for (uint8_t col = 0; changes; col++, changes >>= 1) {
+        if (changes & MATRIX_ROW_SHIFTER) {
+            matrix_key_time[row][col] = time;
+        }
+    }
+}
+
+/**
+ * @brief Stamp every switch whose raw state differs between two scans.
+ *
+ * Debouncing only ever reports a state once it has been read from the
+ * switch, so the time of the last raw change of a key is the capture time
+ * of any debounced edge it later produces.
+ */
+void matrix_stamp_raw_changes(const matrix_row_t previous[], const matrix_row_t current[], uint8_t row_offset) {
+    const uint16_t now = timer_read();
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        matrix_set_key_times(row + row_offset, previous[row] ^ current[row], now);
+    }
+}
+#endif
+
 #if (MATRIX_COLS <= 8)
 #    define print_matrix_header() print("\nr/c 01234567\n")
 #    define print_matrix_row(row) print_bin_reverse8(matrix_get_row(row))
@@ -109,7 +146,13 @@ bool matrix_post_scan(void) {
             last_connected = false;
         }
 
-        if (changed) memcpy(matrix + thatHand, slave_matrix, sizeof(slave_matrix));
+        if (changed) {
+#    if defined(MATRIX_KEY_TIMESTAMPS) && !defined(SPLIT_MATRIX_DELTA)
+            // With SPLIT_MATRIX_DELTA the transport uses the slave's own capture times
+            matrix_stamp_raw_changes(matrix + thatHand, slave_matrix, thatHand);
+#    endif
+            memcpy(matrix + thatHand, slave_matrix, sizeof(slave_matrix));
+        }
 
         matrix_scan_kb();
     } else {
@@ -166,8 +209,23 @@ __attribute__((weak)) void matrix_init(void) {
 }
 
 __attribute__((weak)) uint8_t matrix_scan(void) {
+#ifdef MATRIX_KEY_TIMESTAMPS
+    matrix_row_t previous_matrix[ROWS_PER_HAND];
+    memcpy(previous_matrix, raw_matrix, sizeof(previous_matrix));
+#endif
+
     bool changed = matrix_scan_custom(raw_matrix);
 
+#ifdef MATRIX_KEY_TIMESTAMPS
+    if (changed) {
+#    ifdef SPLIT_KEYBOARD
+        matrix_stamp_raw_changes(previous_matrix, raw_matrix, thisHand);
+#    else
+        matrix_stamp_raw_changes(previous_matrix, raw_matrix, 0);
+#    endif
+    }
+#endif
+
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
@@ -638,6 +638,15 @@ void mousekey_send(void) {
     host_mouse_send(&mouse_report);
 }
 
+uint32_t mousekey_time_until_next(void) {
+#ifdef MOUSEKEY_INERTIA
+    // The pointer keeps coasting after the keys are released
+    if (mousekey_frame) return 0;
+#endif
+    if (mouse_report.x || mouse_report.y || mouse_report.v || mouse_report.h) return 0;
+    return UINT32_MAX;
+}
+
 void mousekey_clear(void) {
     mouse_report          = (report_mouse_t){};
     mousekey_repeat       = 0;
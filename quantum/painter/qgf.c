@@ -64,7 +64,7 @@ bool qgf_parse_format(qp_image_format_t format, uint8_t *bpp, bool *has_palette,
     return true;
 }
 
-bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, painter_compression_t *compression_scheme, uint16_t *delay) {
+bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, bool *is_continued, painter_compression_t *compression_scheme, uint16_t *delay) {
     // Decode the format
     qgf_parse_format(frame_descriptor->format, bpp, has_palette, is_panel_native);
 
@@ -72,6 +72,9 @@ bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp,
     if (is_delta) {
         *is_delta = (frame_descriptor->flags & QGF_FRAME_FLAG_DELTA) == QGF_FRAME_FLAG_DELTA;
     }
+    if (is_continued) {
+        *is_continued = (frame_descriptor->flags & QGF_FRAME_FLAG_CONTINUED) == QGF_FRAME_FLAG_CONTINUED;
+    }
     if (compression_scheme) {
         *compression_scheme = frame_descriptor->compression_scheme;
     }
@@ -193,7 +196,7 @@ bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, u
         return false;
     }
 
-    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_panel_native, is_delta, NULL, NULL);
+    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_panel_native, is_delta, NULL, NULL, NULL);
 }
 
 bool qgf_validate_palette_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t bpp) {
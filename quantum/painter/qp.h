@@ -56,6 +56,24 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+/**
+ * @def This controls the number of glyphs kept in RAM by \ref qp_drawtext and \ref qp_drawtext_recolor, already
+ *      rendered in the display's native pixel format, keyed by font, code point and colors. Redrawing cached glyphs
+ *      skips the font lookup and decoding entirely. Each glyph requires
+ *      \ref QUANTUM_PAINTER_GLYPH_CACHE_GLYPH_BYTES of RAM. Defaults to 0, disabling the cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 0
+#endif
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_GLYPH_BYTES
+/**
+ * @def This controls the maximum size of a glyph in the glyph cache, in bytes of native pixel data. Glyphs which are
+ *      larger, such as 16x20 glyphs on an RGB565 display, are always rendered from the font.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_GLYPH_BYTES 512
+#endif
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -72,6 +90,15 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+/**
+ * @def This controls whether a second pixel data buffer is allocated, so that images and fonts can be decoded into one
+ *      buffer while the other is still being transmitted to the display. Only has an effect on displays which can
+ *      transmit in the background, such as SPI panels on ChibiOS, and doubles the RAM used by the pixel data buffer.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER FALSE
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
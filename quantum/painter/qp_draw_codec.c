@@ -136,7 +136,7 @@ bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg
 
     // If we've hit the transmit limit, send out the entire buffer and reset the write position
     if (state->pixel_write_pos == state->max_pixels) {
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+        if (!qp_internal_pixdata_send(state->device, state->pixel_write_pos)) {
             return false;
         }
         state->pixel_write_pos = 0;
@@ -155,8 +155,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
 
     // If we've hit the transmit limit, send out the entire buffer and reset the write position
     if (state->byte_write_pos == state->max_bytes) {
-        painter_driver_t* driver = (painter_driver_t*)state->device;
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+        if (!qp_internal_pixdata_send(state->device, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
             return false;
         }
         state->byte_write_pos = 0;
@@ -165,6 +164,147 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Bulk decode of memory streams
+
+// Number of source bytes decoded at a time -- up to 8x as many palette indices are unpacked from them
+#define QP_BULK_DECODE_BYTES 32
+
+// Kept out of the stack frame, same as the pixdata buffer
+static uint8_t qp_internal_bulk_bytes[QP_BULK_DECODE_BYTES];
+static uint8_t qp_internal_bulk_indices[QP_BULK_DECODE_BYTES * 8];
+
+// Returns the memory stream behind the input state, if the input callback is one of our decoders reading from one
+static qp_memory_stream_t* qp_internal_bulk_stream(qp_internal_byte_input_callback input_callback, void* input_state) {
+    if (input_callback != qp_drawimage_byte_uncompressed_decoder && input_callback != qp_drawimage_byte_rle_decoder) {
+        return NULL;
+    }
+    return qp_stream_as_memory_stream(((qp_internal_byte_input_state_t*)input_state)->src_stream);
+}
+
+// Equivalent to calling input_callback count times, but copies runs straight out of the memory stream's buffer. Returns the number of bytes read before any failure.
+static uint8_t qp_internal_bulk_read(qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t* state, qp_memory_stream_t* mem, uint8_t* dest, uint8_t count) {
+    uint8_t n = 0;
+    while (n < count) {
+        uint8_t chunk     = count - n;
+        int32_t available = mem->length - mem->position;
+
+        if (input_callback == qp_drawimage_byte_uncompressed_decoder) {
+            if (available < chunk) break;
+            memcpy(&dest[n], &mem->buffer[mem->position], chunk);
+            mem->position += chunk;
+            state->curr = dest[n + chunk - 1];
+        } else if (state->rle.mode == MARKER_BYTE) {
+            // Let the regular decoder parse the marker, it hands back the first byte of the run
+            chunk   = 1;
+            dest[n] = qp_drawimage_byte_rle_decoder(state);
+        } else {
+            if (chunk > state->rle.remain) {
+                chunk = state->rle.remain;
+            }
+            if (state->rle.mode == REPEATING_RUN) {
+                memset(&dest[n], (uint8_t)state->curr, chunk);
+            } else {
+                // The current byte has already been read, the rest of the run follows it in the buffer
+                if (available < chunk - 1) break;
+                dest[n] = state->curr;
+                memcpy(&dest[n + 1], &mem->buffer[mem->position], chunk - 1);
+                mem->position += chunk - 1;
+                if (state->rle.remain > chunk) {
+                    state->curr = qp_stream_get(mem);
+                }
+            }
+            state->rle.remain -= chunk;
+            if (state->rle.remain == 0) {
+                state->rle.mode = MARKER_BYTE;
+            }
+        }
+        n += chunk;
+    }
+
+    // Anything left runs into the end of the stream, so leave the regular decoder to deal with it
+    for (; n < count; ++n) {
+        int16_t byteval = input_callback(state);
+        if (byteval < 0) {
+            break;
+        }
+        dest[n] = byteval;
+    }
+    return n;
+}
+
+// Equivalent to qp_internal_decode_palette + qp_internal_pixel_appender, handing blocks of palette indices to the driver at once
+static bool qp_internal_bulk_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t* input_state, qp_memory_stream_t* mem, qp_internal_pixel_output_state_t* output_state) {
+    painter_driver_t* driver           = (painter_driver_t*)device;
+    const uint8_t     pixel_bitmask    = (1 << bits_per_pixel) - 1;
+    const uint8_t     pixels_per_byte  = 8 / bits_per_pixel;
+    uint32_t          remaining_pixels = pixel_count;
+    while (remaining_pixels > 0) {
+        uint32_t byte_count = (remaining_pixels + pixels_per_byte - 1) / pixels_per_byte;
+        if (byte_count > QP_BULK_DECODE_BYTES) {
+            byte_count = QP_BULK_DECODE_BYTES;
+        }
+        uint8_t bytes_read = qp_internal_bulk_read(input_callback, input_state, mem, qp_internal_bulk_bytes, byte_count);
+
+        // Unpack the palette indices, low bits first
+        uint16_t num_indices = 0;
+        for (uint8_t i = 0; i < bytes_read; ++i) {
+            uint8_t byteval = qp_internal_bulk_bytes[i];
+            for (uint8_t q = 0; q < pixels_per_byte && num_indices < remaining_pixels; ++q) {
+                qp_internal_bulk_indices[num_indices++] = byteval & pixel_bitmask;
+                byteval >>= bits_per_pixel;
+            }
+        }
+        remaining_pixels -= num_indices;
+
+        // Convert them into the pixdata buffer, sending it whenever it fills up
+        uint16_t done = 0;
+        while (done < num_indices) {
+            uint32_t chunk = output_state->max_pixels - output_state->pixel_write_pos;
+            if (chunk > num_indices - done) {
+                chunk = num_indices - done;
+            }
+            if (!driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, output_state->pixel_write_pos, chunk, &qp_internal_bulk_indices[done])) {
+                return false;
+            }
+            output_state->pixel_write_pos += chunk;
+            done += chunk;
+
+            if (output_state->pixel_write_pos == output_state->max_pixels) {
+                if (!qp_internal_pixdata_send(device, output_state->pixel_write_pos)) {
+                    return false;
+                }
+                output_state->pixel_write_pos = 0;
+            }
+        }
+
+        // Bail out only after the pixels preceding a read failure have gone out, same as qp_internal_decode_palette
+        if (bytes_read < byte_count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Equivalent to qp_internal_send_bytes + qp_internal_byte_appender for native pixel data
+static bool qp_internal_bulk_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t* input_state, qp_memory_stream_t* mem, qp_internal_byte_output_state_t* output_state) {
+    uint32_t remaining_bytes = byte_count;
+    while (remaining_bytes > 0) {
+        uint8_t count = remaining_bytes < QP_BULK_DECODE_BYTES ? remaining_bytes : QP_BULK_DECODE_BYTES;
+        uint8_t bytes_read = qp_internal_bulk_read(input_callback, input_state, mem, qp_internal_bulk_bytes, count);
+        for (uint8_t i = 0; i < bytes_read; ++i) {
+            if (!qp_internal_byte_appender(qp_internal_bulk_bytes[i], output_state)) {
+                return false;
+            }
+        }
+        if (bytes_read < count) {
+            return false;
+        }
+        remaining_bytes -= count;
+    }
+    return true;
+}
+
 // Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
     painter_driver_t* driver = (painter_driver_t*)device;
@@ -177,10 +317,15 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
         // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        qp_memory_stream_t* mem = qp_internal_bulk_stream(input_callback, input_state);
+        if (mem) {
+            ret = qp_internal_bulk_decode_palette(device, pixel_count, bpp, input_callback, input_state, mem, &output_state);
+        } else {
+            ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        }
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+            ret &= qp_internal_pixdata_send(device, output_state.pixel_write_pos);
         }
     }
 
@@ -193,11 +338,16 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
 
         // Stream the raw pixel data to the display
-        uint32_t byte_count = pixel_count * bpp / 8;
-        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
+        uint32_t            byte_count = pixel_count * bpp / 8;
+        qp_memory_stream_t* mem        = qp_internal_bulk_stream(input_callback, input_state);
+        if (mem) {
+            ret = qp_internal_bulk_send_bytes(device, byte_count, input_callback, input_state, mem, &output_state);
+        } else {
+            ret = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
+        }
         // Any leftovers need transmission as well.
         if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+            ret &= qp_internal_pixdata_send(device, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
         }
     }
 
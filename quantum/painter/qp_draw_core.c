@@ -20,7 +20,12 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //
 
 // Buffer used for transmitting native pixel data to the downstream device.
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t                                       *qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[0];
+#else
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -47,6 +52,24 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y)
     return driver->driver_vtable->viewport(device, x, y, x, y) && driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, 1);
 }
 
+// Transmits the pixdata buffer, leaving it to complete in the background if the device supports it
+bool qp_internal_pixdata_send(painter_device_t device, uint32_t native_pixel_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    if (driver->driver_vtable->pixdata_async) {
+        if (!driver->driver_vtable->pixdata_async(device, qp_internal_global_pixdata_buffer, native_pixel_count)) {
+            return false;
+        }
+
+        // The buffer being sent mustn't be touched until the transfer completes, which happens at the latest when the
+        // next one is started, so carry on in the other buffer.
+        qp_internal_global_pixdata_buffer = qp_internal_global_pixdata_buffer == qp_internal_pixdata_buffers[0] ? qp_internal_pixdata_buffers[1] : qp_internal_pixdata_buffers[0];
+        return true;
+    }
+#endif
+    return driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, native_pixel_count);
+}
+
 // Fills the global native pixel buffer with equivalent pixels matching the supplied HSV
 void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint8_t hue, uint8_t sat, uint8_t val) {
     painter_driver_t *driver            = (painter_driver_t *)device;
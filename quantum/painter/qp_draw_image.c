@@ -117,6 +117,7 @@ typedef struct qgf_frame_info_t {
     bool                  has_palette;
     bool                  is_panel_native;
     bool                  is_delta;
+    bool                  is_continued;
     uint16_t              left;
     uint16_t              top;
     uint16_t              right;
@@ -144,7 +145,7 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     }
 
     // Parse out the frame info
-    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_panel_native, &info->is_delta, &info->compression_scheme, &info->delay)) {
+    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_panel_native, &info->is_delta, &info->is_continued, &info->compression_scheme, &info->delay)) {
         return false;
     }
 
@@ -305,13 +306,23 @@ static animation_state_t   animation_states[QUANTUM_PAINTER_CONCURRENT_ANIMATION
 static deferred_token qp_render_animation_state(animation_state_t *state, uint16_t *delay_ms) {
     qgf_frame_info_t frame_info = {0};
     qp_dprintf("qp_render_animation_state: entry (frame #%d)\n", (int)state->frame_number);
-    bool ret = qp_drawimage_recolor_impl(state->device, state->x, state->y, state->image, state->frame_number, &frame_info, state->fg_hsv888, state->bg_hsv888);
-    if (ret) {
+
+    // Continued frames are drawn along with the next one, which lets a single animation step be made up of several
+    // delta rectangles -- bounded by the frame count in case every frame in the image is marked as continued
+    bool ret = false;
+    for (uint16_t drawn = 0; drawn < state->image->frame_count; ++drawn) {
+        ret = qp_drawimage_recolor_impl(state->device, state->x, state->y, state->image, state->frame_number, &frame_info, state->fg_hsv888, state->bg_hsv888);
+        if (!ret) {
+            break;
+        }
         ++state->frame_number;
         if (state->frame_number >= state->image->frame_count) {
             state->frame_number = 0;
         }
         *delay_ms = frame_info.delay;
+        if (!frame_info.is_continued) {
+            break;
+        }
     }
     qp_dprintf("qp_render_animation_state: %s (delay %dms)\n", ret ? "ok" : "fail", (int)(*delay_ms));
     return ret;
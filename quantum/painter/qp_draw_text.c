@@ -36,6 +36,77 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+typedef struct qp_glyph_cache_entry_t {
+    qff_font_handle_t *font; // NULL if unused
+    painter_device_t   device;
+    uint32_t           code_point;
+    qp_pixel_t         fg_hsv888;
+    qp_pixel_t         bg_hsv888;
+    uint8_t            width;
+    uint32_t           last_used;
+    uint8_t            pixdata[QUANTUM_PAINTER_GLYPH_CACHE_GLYPH_BYTES];
+} qp_glyph_cache_entry_t;
+
+static qp_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_SIZE] = {0};
+static uint32_t               glyph_cache_clock                             = 0;
+
+// Finds a cached glyph. Without a device, any rendering of the glyph matches, which is enough to know its width.
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(qff_font_handle_t *qff_font, uint32_t code_point, painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_SIZE; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->font != qff_font || entry->code_point != code_point) {
+            continue;
+        }
+        if (device && (entry->device != device || memcmp(&entry->fg_hsv888.hsv888, &fg_hsv888.hsv888, sizeof(fg_hsv888.hsv888)) != 0 || memcmp(&entry->bg_hsv888.hsv888, &bg_hsv888.hsv888, sizeof(bg_hsv888.hsv888)) != 0)) {
+            continue;
+        }
+        entry->last_used = ++glyph_cache_clock;
+        return entry;
+    }
+    return NULL;
+}
+
+// Picks the entry to render a new glyph into, evicting the least recently used one
+static qp_glyph_cache_entry_t *qp_glyph_cache_alloc(void) {
+    qp_glyph_cache_entry_t *oldest = &glyph_cache[0];
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_SIZE; ++i) {
+        if (!glyph_cache[i].font) {
+            return &glyph_cache[i];
+        }
+        if (glyph_cache[i].last_used < oldest->last_used) {
+            oldest = &glyph_cache[i];
+        }
+    }
+    return oldest;
+}
+
+// Drops all glyphs of a font, so they can't be mistaken for glyphs of a font later loaded into the same slot
+static void qp_glyph_cache_evict_font(qff_font_handle_t *qff_font) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_SIZE; ++i) {
+        if (glyph_cache[i].font == qff_font) {
+            glyph_cache[i].font = NULL;
+        }
+    }
+}
+
+typedef struct qp_glyph_cache_output_state_t {
+    painter_device_t        device;
+    qp_glyph_cache_entry_t *entry;
+    uint32_t                pixel_write_pos;
+} qp_glyph_cache_output_state_t;
+
+// Pixel output callback, rendering into a cache entry instead of the pixdata buffer
+static bool qp_glyph_cache_pixel_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state  = (qp_glyph_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->entry->pixdata, palette, state->pixel_write_pos++, 1, &index);
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -151,6 +222,10 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    qp_glyph_cache_evict_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -160,8 +235,8 @@ bool qp_close_font(painter_font_handle_t font) {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helpers
 
-// Callback to be invoked for each codepoint detected in the UTF8 input string
-typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
+// Callback to be invoked for each codepoint detected in the UTF8 input string -- glyph_ready is false if the stream wasn't positioned at the glyph's data, as its width was already known
+typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, bool glyph_ready, void *cb_arg);
 
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
@@ -302,13 +377,23 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
-        uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        uint8_t width       = 0;
+        bool    glyph_ready = true;
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+        // Cached glyphs don't need looking up in the font just to get their width
+        qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(qff_font, code_point, NULL, (qp_pixel_t){0}, (qp_pixel_t){0});
+        if (entry) {
+            width       = entry->width;
+            glyph_ready = false;
+        }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+        if (glyph_ready && !qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
             qp_dprintf("Failed to prepare glyph for rendering.\n");
             return false;
         }
 
-        if (!handler(qff_font, code_point, width, qff_font->base.line_height, cb_arg)) {
+        if (!handler(qff_font, code_point, width, qff_font->base.line_height, glyph_ready, cb_arg)) {
             qp_dprintf("Failed to execute glyph handler.\n");
             return false;
         }
@@ -325,7 +410,7 @@ typedef struct code_point_iter_calcwidth_state_t {
 } code_point_iter_calcwidth_state_t;
 
 // Codepoint handler callback: width calc
-static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, bool glyph_ready, void *cb_arg) {
     code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
 
     // Increment the overall width by this glyph's width
@@ -345,27 +430,108 @@ typedef struct code_point_iter_drawglyph_state_t {
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
+    qp_pixel_t                        fg_hsv888;
+    qp_pixel_t                        bg_hsv888;
+    bool                              font_ready; // palette set up, deferred until a glyph actually needs decoding
 } code_point_iter_drawglyph_state_t;
 
+// Sets up the palette on first use, and makes sure the stream is positioned at the glyph's data
+static inline bool qp_drawtext_prepare_glyph_for_decode(code_point_iter_drawglyph_state_t *state, qff_font_handle_t *qff_font, uint32_t code_point, bool glyph_ready) {
+    if (!state->font_ready) {
+        uint32_t data_offset;
+        if (!qp_drawtext_prepare_font_for_render(state->device, qff_font, state->fg_hsv888, state->bg_hsv888, &data_offset)) {
+            qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
+            return false;
+        }
+        state->font_ready = true;
+
+        // Reading the palette moved the stream
+        if (qff_font->has_palette) {
+            glyph_ready = false;
+        }
+    }
+
+    uint8_t width;
+    return glyph_ready || qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width);
+}
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+// Renders a glyph into the cache, in the device's native pixel format
+static qp_glyph_cache_entry_t *qp_glyph_cache_render(code_point_iter_drawglyph_state_t *state, qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint32_t pixel_count, bool glyph_ready) {
+    if (!qp_drawtext_prepare_glyph_for_decode(state, qff_font, code_point, glyph_ready)) {
+        return NULL;
+    }
+
+    // Invalidate the entry until rendering has succeeded
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_alloc();
+    entry->font                   = NULL;
+
+    state->input_state->rle.mode               = MARKER_BYTE; // ignored if not using RLE
+    qp_glyph_cache_output_state_t output_state = {.device = state->device, .entry = entry, .pixel_write_pos = 0};
+    if (!qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_glyph_cache_pixel_appender, &output_state)) {
+        return NULL;
+    }
+
+    entry->font       = qff_font;
+    entry->device     = state->device;
+    entry->code_point = code_point;
+    entry->fg_hsv888  = state->fg_hsv888;
+    entry->bg_hsv888  = state->bg_hsv888;
+    entry->width      = width;
+    entry->last_used  = ++glyph_cache_clock;
+    return entry;
+}
+
+// Copies a cached glyph through the pixdata buffer to the current viewport
+static bool qp_glyph_cache_send(painter_device_t device, qp_glyph_cache_entry_t *entry, uint32_t pixel_count) {
+    painter_driver_t *driver     = (painter_driver_t *)device;
+    uint32_t          max_pixels = qp_internal_num_pixels_in_buffer(device);
+    for (uint32_t offset = 0; offset < pixel_count; offset += max_pixels) {
+        uint32_t chunk = QP_MIN(pixel_count - offset, max_pixels);
+        memcpy(qp_internal_global_pixdata_buffer, &entry->pixdata[offset * driver->native_bits_per_pixel / 8], (chunk * driver->native_bits_per_pixel + 7) / 8);
+        if (!qp_internal_pixdata_send(device, chunk)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 // Codepoint handler callback: drawing
-static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, bool glyph_ready, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
-    state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
-
-    // Reset the output state
-    state->output_state->pixel_write_pos = 0;
-
     // Configure where we're going to be rendering to
     driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
 
     // Move the x-position for the next glyph
     state->xpos += width;
 
-    // Decode the pixel data for the glyph, and stream it
     uint32_t pixel_count = ((uint32_t)width) * height;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Palette-based glyphs small enough for the cache are only decoded once for each device and set of colors
+    if (qff_font->bpp <= 8 && (pixel_count * driver->native_bits_per_pixel + 7) / 8 <= QUANTUM_PAINTER_GLYPH_CACHE_GLYPH_BYTES) {
+        qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(qff_font, code_point, state->device, state->fg_hsv888, state->bg_hsv888);
+        if (!entry) {
+            entry = qp_glyph_cache_render(state, qff_font, code_point, width, pixel_count, glyph_ready);
+        }
+        return entry && qp_glyph_cache_send(state->device, entry, pixel_count);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+    if (!qp_drawtext_prepare_glyph_for_decode(state, qff_font, code_point, glyph_ready)) {
+        return false;
+    }
+
+    // Reset the input state's RLE mode -- the stream is now positioned at the glyph's data
+    state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
+
+    // Reset the output state
+    state->output_state->pixel_write_pos = 0;
+
+    // Decode the pixel data for the glyph, and stream it
     return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
 }
 
@@ -428,6 +594,13 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     // Set up the pixel output state
     qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
+    // Fonts with their own palette ignore the colors, so don't let them affect caching either
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    if (qff_font->has_palette) {
+        fg_hsv888 = bg_hsv888 = (qp_pixel_t){.hsv888 = {.h = 0, .s = 0, .v = 0}};
+    }
+
     // Set up the codepoint iteration state
     code_point_iter_drawglyph_state_t state = {// Common
                                                .device = device,
@@ -437,16 +610,11 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
                                                // Output
-                                               .output_state = &output_state};
-
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
-    if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
-        qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
-        qp_comms_stop(device);
-        return false;
-    }
+                                               .output_state = &output_state,
+                                               // Palette
+                                               .fg_hsv888  = fg_hsv888,
+                                               .bg_hsv888  = bg_hsv888,
+                                               .font_ready = false};
 
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
@@ -29,6 +29,9 @@ typedef struct painter_driver_vtable_t {
     painter_driver_convert_palette_func palette_convert;
     painter_driver_append_pixels        append_pixels;
     painter_driver_append_pixdata       append_pixdata;
+
+    // Optional, may return before the pixel data has been transmitted -- see QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    painter_driver_pixdata_func pixdata_async;
 } painter_driver_vtable_t;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -44,6 +47,9 @@ typedef struct painter_comms_vtable_t {
     painter_driver_comms_start_func comms_start;
     painter_driver_comms_stop_func  comms_stop;
     painter_driver_comms_send_func  comms_send;
+
+    // Optional, may return before the data has been transmitted. Any subsequent comms operation waits for it to complete.
+    painter_driver_comms_send_func comms_send_async;
 } painter_comms_vtable_t;
 
 typedef void (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
@@ -119,6 +119,10 @@ qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     return stream;
 }
 
+qp_memory_stream_t *qp_stream_as_memory_stream(qp_stream_t *stream) {
+    return (stream && stream->get == mem_get) ? (qp_memory_stream_t *)stream : NULL;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
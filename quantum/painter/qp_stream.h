@@ -70,6 +70,9 @@ typedef struct qp_memory_stream_t {
 
 qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length);
 
+// Returns the stream as a memory stream, allowing direct access to its buffer, or NULL if it is some other kind of stream
+qp_memory_stream_t *qp_stream_as_memory_stream(qp_stream_t *stream);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
@@ -20,6 +20,7 @@
 #include <string.h>
 #include "timer.h"
 #include "gpio.h"
+#include "util.h"
 
 #ifdef MOUSEKEY_ENABLE
 #    include "mousekey.h"
@@ -66,6 +67,64 @@ uint16_t pointing_device_get_shared_cpi(void) {
     return shared_cpi;
 }
 
+#    ifdef SPLIT_POINTING_ACCUMULATE
+// Motion received from the other side which hasn't been reported yet
+static int16_t shared_motion_x = 0;
+static int16_t shared_motion_y = 0;
+static int16_t shared_motion_h = 0;
+static int16_t shared_motion_v = 0;
+
+/**
+ * @brief Adds two motion values, saturating at the limits of int16_t
+ *
+ * NOTE : Only available when using SPLIT_POINTING_ENABLE and SPLIT_POINTING_ACCUMULATE
+ *
+ * @param[in] total int16_t
+ * @param[in] delta int16_t
+ * @return int16_t the saturated sum
+ */
+int16_t pointing_device_motion_add(int16_t total, int16_t delta) {
+    int32_t sum = (int32_t)total + delta;
+    return MAX(INT16_MIN, MIN(INT16_MAX, sum));
+}
+
+/**
+ * @brief Adds motion accumulated by the other side to the shared report
+ *
+ * Unlike pointing_device_set_shared_report, motion received between two reports is added up, and anything which
+ * doesn't fit in a single report is carried over to the next ones.
+ *
+ * NOTE : Only available when using SPLIT_POINTING_ENABLE and SPLIT_POINTING_ACCUMULATE
+ *
+ * @param[in] buttons uint8_t current buttons of the other side
+ * @param[in] x int16_t
+ * @param[in] y int16_t
+ * @param[in] h int16_t
+ * @param[in] v int16_t
+ */
+void pointing_device_add_shared_motion(uint8_t buttons, int16_t x, int16_t y, int16_t h, int16_t v) {
+    shared_mouse_report.buttons = buttons;
+    shared_motion_x             = pointing_device_motion_add(shared_motion_x, x);
+    shared_motion_y             = pointing_device_motion_add(shared_motion_y, y);
+    shared_motion_h             = pointing_device_motion_add(shared_motion_h, h);
+    shared_motion_v             = pointing_device_motion_add(shared_motion_v, v);
+}
+
+/**
+ * @brief Moves as much of the accumulated motion as fits into the shared report
+ */
+static void pointing_device_take_shared_motion(void) {
+    shared_mouse_report.x = MAX(XY_REPORT_MIN, MIN(XY_REPORT_MAX, shared_motion_x));
+    shared_mouse_report.y = MAX(XY_REPORT_MIN, MIN(XY_REPORT_MAX, shared_motion_y));
+    shared_mouse_report.h = MAX(INT8_MIN, MIN(INT8_MAX, shared_motion_h));
+    shared_mouse_report.v = MAX(INT8_MIN, MIN(INT8_MAX, shared_motion_v));
+    shared_motion_x -= shared_mouse_report.x;
+    shared_motion_y -= shared_mouse_report.y;
+    shared_motion_h -= shared_mouse_report.h;
+    shared_motion_v -= shared_mouse_report.v;
+}
+#    endif // SPLIT_POINTING_ACCUMULATE
+
 #    if defined(POINTING_DEVICE_LEFT)
 #        define POINTING_DEVICE_THIS_SIDE is_keyboard_left()
 #    elif defined(POINTING_DEVICE_RIGHT)
@@ -78,6 +137,9 @@ uint16_t pointing_device_get_shared_cpi(void) {
 
 static report_mouse_t local_mouse_report         = {};
 static bool           pointing_device_force_send = false;
+#if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
+static uint32_t pointing_device_last_exec = 0;
+#endif
 
 extern const pointing_device_driver_t pointing_device_driver;
 
@@ -234,11 +296,10 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
 
 #if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
-    static uint32_t last_exec = 0;
-    if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
+    if (timer_elapsed32(pointing_device_last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
         return false;
     }
-    last_exec = timer_read32();
+    pointing_device_last_exec = timer_read32();
 #endif
 
     // Gather report info
@@ -255,6 +316,9 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
 
 #if defined(SPLIT_POINTING_ENABLE)
+#    if defined(SPLIT_POINTING_ACCUMULATE)
+        pointing_device_take_shared_motion();
+#    endif
 #    if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
         local_mouse_report.buttons = old_buttons;
@@ -303,6 +367,39 @@ __attribute__((weak)) bool pointing_device_task(void) {
     return send_report;
 }
 
+/**
+ * @brief Time until the pointing device next needs to be polled
+ *
+ * @return milliseconds until pointing_device_task next reads the sensor, or UINT32_MAX if it doesn't need to
+ */
+uint32_t pointing_device_time_until_next(void) {
+#if defined(SPLIT_POINTING_ENABLE)
+    if (!is_keyboard_master()) {
+        // The split transactions read this side's sensor on every pass
+        return (POINTING_DEVICE_THIS_SIDE) ? 0 : UINT32_MAX;
+    }
+#endif
+
+#if defined(POINTING_DEVICE_MOTION_PIN) && !defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
+    // Nothing to read until the sensor signals motion, which is picked up like a key press
+#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    if (gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
+#    else
+    if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
+#    endif
+    {
+        return UINT32_MAX;
+    }
+#endif
+
+#if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
+    uint32_t elapsed = timer_elapsed32(pointing_device_last_exec);
+    return elapsed < POINTING_DEVICE_TASK_THROTTLE_MS ? POINTING_DEVICE_TASK_THROTTLE_MS - elapsed : 0;
+#else
+    return 0;
+#endif
+}
+
 /**
  * @brief Gets current mouse report used by pointing device task
  *
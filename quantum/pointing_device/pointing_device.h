@@ -104,6 +104,7 @@ typedef int16_t clamp_range_t;
 
 void           pointing_device_init(void);
 bool           pointing_device_task(void);
+uint32_t       pointing_device_time_until_next(void);
 bool           pointing_device_send(void);
 report_mouse_t pointing_device_get_report(void);
 void           pointing_device_set_report(report_mouse_t mouse_report);
@@ -121,6 +122,10 @@ void           pointing_device_keycode_handler(uint16_t keycode, bool pressed);
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
 uint16_t pointing_device_get_shared_cpi(void);
+#    if defined(SPLIT_POINTING_ACCUMULATE)
+void    pointing_device_add_shared_motion(uint8_t buttons, int16_t x, int16_t y, int16_t h, int16_t v);
+int16_t pointing_device_motion_add(int16_t total, int16_t delta);
+#    endif
 #    if !defined(POINTING_DEVICE_TASK_THROTTLE_MS)
 #        define POINTING_DEVICE_TASK_THROTTLE_MS 1
 #    endif
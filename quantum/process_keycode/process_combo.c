@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -26,6 +27,11 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "debug.h"
+
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -73,6 +79,11 @@ __attribute__((weak)) bool combo_should_trigger(uint16_t combo_index, combo_t *c
 
 #ifndef COMBO_NO_TIMER
 static uint16_t timer = 0;
+#    ifdef MATRIX_KEY_TIMESTAMPS
+#        define COMBO_KEY_TIME(record) ((record)->event.time)
+#    else
+#        define COMBO_KEY_TIME(record) timer_read()
+#    endif
 #endif
 static bool     b_combo_enable = true; // defaults to enabled
 static uint16_t longest_term   = 0;
@@ -191,9 +202,120 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
     return COMBO_TERM;
 }
 
+#ifdef COMBO_INDEX
+/* Keycode to combo index, sorted by keycode and then by combo. Built on
+ * first use, and again whenever combo_count() changes. */
+static uint16_t combo_index_keycodes[COMBO_INDEX_SIZE];
+static uint16_t combo_index_combos[COMBO_INDEX_SIZE];
+static uint16_t combo_index_length = 0;
+static uint16_t combo_index_count  = 0;
+static bool     combo_index_built  = false;
+static bool     combo_index_valid  = false;
+
+/* Combos which may have some state to reset. Superset of the combos with
+ * keys down, active or disabled. */
+static uint8_t combo_alive[(COMBO_INDEX_SIZE + 7) / 8];
+
+#    define COMBO_ALIVE(index) (combo_alive[(index) / 8] & (1 << ((index) % 8)))
+#    define COMBO_ALIVE_SET(index) (combo_alive[(index) / 8] |= (1 << ((index) % 8)))
+#    define COMBO_ALIVE_CLEAR(index) (combo_alive[(index) / 8] &= ~(1 << ((index) % 8)))
+
+static bool combo_index_build(void) {
+    uint16_t count = combo_count();
+
+    combo_index_length = 0;
+    combo_index_count  = count;
+    combo_index_built  = true;
+    // Every combo has at least one key, so this also bounds the alive bitset
+    combo_index_valid = count <= COMBO_INDEX_SIZE;
+
+    for (uint16_t idx = 0; combo_index_valid && idx < count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        for (uint8_t i = 0;; ++i) {
+            uint16_t keycode = pgm_read_word(&keys[i]);
+            if (COMBO_END == keycode) break;
+            if (combo_index_length == COMBO_INDEX_SIZE) {
+                combo_index_valid = false;
+                break;
+            }
+
+            // Insertion sort, keeping entries of the same keycode in combo order
+            uint16_t pos = combo_index_length;
+            while (pos > 0 && combo_index_keycodes[pos - 1] > keycode) {
+                combo_index_keycodes[pos] = combo_index_keycodes[pos - 1];
+                combo_index_combos[pos]   = combo_index_combos[pos - 1];
+                pos--;
+            }
+            if (pos > 0 && combo_index_keycodes[pos - 1] == keycode && combo_index_combos[pos - 1] == idx) {
+                // Same keycode twice in one combo, undo the shift
+                for (; pos < combo_index_length; pos++) {
+                    combo_index_keycodes[pos] = combo_index_keycodes[pos + 1];
+                    combo_index_combos[pos]   = combo_index_combos[pos + 1];
+                }
+                continue;
+            }
+            combo_index_keycodes[pos] = keycode;
+            combo_index_combos[pos]   = idx;
+            combo_index_length++;
+        }
+    }
+
+    if (!combo_index_valid) {
+        dprintf("COMBO: COMBO_INDEX_SIZE too small, falling back to a linear scan\n");
+    }
+
+    // State may predate the index, so let the next clear_combos() visit everything
+    memset(combo_alive, 0xFF, sizeof(combo_alive));
+    return combo_index_valid;
+}
+
+static bool combo_index_ready(void) {
+    if (!combo_index_built || combo_index_count != combo_count()) {
+        return combo_index_build();
+    }
+    return combo_index_valid;
+}
+
+/* Find the range of index entries for keycode. */
+static void combo_index_find(uint16_t keycode, uint16_t *first, uint16_t *last) {
+    uint16_t lo = 0, hi = combo_index_length;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (combo_index_keycodes[mid] < keycode) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *first = lo;
+    while (lo < combo_index_length && combo_index_keycodes[lo] == keycode) {
+        lo++;
+    }
+    *last = lo;
+}
+#endif
+
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_INDEX
+    if (combo_index_ready()) {
+        for (index = 0; index < combo_index_count; ++index) {
+            if ((index % 8) == 0 && !combo_alive[index / 8]) {
+                index += 7;
+                continue;
+            }
+            if (COMBO_ALIVE(index)) {
+                combo_t *combo = combo_get(index);
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                    COMBO_ALIVE_CLEAR(index);
+                }
+            }
+        }
+        return;
+    }
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -226,6 +348,11 @@ static inline void dump_key_buffer(void) {
         if (!record->keycode && qrecord->combo_index != (uint16_t)-1) {
             process_combo_event(qrecord->combo_index, true);
         } else {
+#ifdef LATENCY_TRACE_ENABLE
+            if (IS_KEYEVENT(record->event)) {
+                latency_trace_combo_released(record->event);
+            }
+#endif
 #ifndef NO_ACTION_TAPPING
             action_tapping_process(*record);
 #else
@@ -329,6 +456,12 @@ void apply_combo(uint16_t combo_index, combo_t *combo) {
             continue;
         }
 
+#ifdef LATENCY_TRACE_ENABLE
+        if (IS_KEYEVENT(record->event)) {
+            latency_trace_combo_consumed(record->event, combo->keycode);
+        }
+#endif
+
         KEY_STATE_DOWN(state, key_index);
         if (ALL_COMBO_KEYS_ARE_DOWN(state, key_count)) {
             // this in the end executes the combo when the key_buffer is dumped.
@@ -508,6 +641,9 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 #endif
         } else if (COMBO_ACTIVE(combo) && ONLY_ONE_KEY_IS_DOWN(COMBO_STATE(combo)) && KEY_NOT_YET_RELEASED(COMBO_STATE(combo), key_index)) {
             /* last key released */
+#ifdef LATENCY_TRACE_ENABLE
+            latency_trace_combo_consumed(record->event, combo->keycode);
+#endif
             release_combo(combo_index, combo);
             key_is_part_of_combo = true;
 
@@ -517,6 +653,9 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
         } else if (COMBO_ACTIVE(combo) && KEY_NOT_YET_RELEASED(COMBO_STATE(combo), key_index)) {
             /* first or middle key released */
             key_is_part_of_combo = true;
+#ifdef LATENCY_TRACE_ENABLE
+            latency_trace_combo_consumed(record->event, combo->keycode);
+#endif
 
 #ifdef COMBO_PROCESS_KEY_RELEASE
             if (process_combo_key_release(combo_index, combo, key_index, keycode)) {
@@ -564,10 +703,25 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX
+    if (combo_index_ready()) {
+        /* Only visit the combos containing this keycode. */
+        uint16_t first, last;
+        combo_index_find(keycode, &first, &last);
+        for (uint16_t i = first; i < last; ++i) {
+            uint16_t idx   = combo_index_combos[i];
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            COMBO_ALIVE_SET(idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -575,10 +729,10 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_STRICT_TIMER
         if (!timer) {
             // timer is set only on the first key
-            timer = timer_read();
+            timer = COMBO_KEY_TIME(record);
         }
 #    else
-        timer = timer_read();
+        timer = COMBO_KEY_TIME(record);
 #    endif
 #endif
 
@@ -625,6 +779,16 @@ void combo_task(void) {
 #endif
 }
 
+uint32_t combo_time_until_next(void) {
+#ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        uint16_t elapsed = timer_elapsed(timer);
+        return elapsed <= longest_term ? longest_term - elapsed + 1 : 0;
+    }
+#endif
+    return UINT32_MAX;
+}
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
@@ -35,6 +35,9 @@
 #ifndef COMBO_KEY_BUFFER_LENGTH
 #    define COMBO_KEY_BUFFER_LENGTH MAX_COMBO_LENGTH
 #endif
+#ifndef COMBO_INDEX_SIZE
+#    define COMBO_INDEX_SIZE 256
+#endif
 #ifndef COMBO_BUFFER_LENGTH
 #    define COMBO_BUFFER_LENGTH 4
 #endif
@@ -74,7 +77,8 @@ typedef struct combo_t {
 #define KEYCODE_IS_MOD(code) (IS_MODIFIER_KEYCODE(code) || (IS_QK_MODS(code) && !QK_MODS_GET_BASIC_KEYCODE(code)))
 
 bool process_combo(uint16_t keycode, keyrecord_t *record);
-void combo_task(void);
+void     combo_task(void);
+uint32_t combo_time_until_next(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
 void combo_enable(void);
@@ -319,6 +319,17 @@ void music_task(void) {
     }
 }
 
+uint32_t music_time_until_next(void) {
+    if (!music_sequence_playing) {
+        return UINT32_MAX;
+    }
+    if (music_sequence_timer == 0) {
+        return 0;
+    }
+    uint16_t elapsed = timer_elapsed(music_sequence_timer);
+    return elapsed > music_sequence_interval ? 0 : music_sequence_interval - elapsed + 1;
+}
+
 __attribute__((weak)) void music_on_user(void) {}
 
 __attribute__((weak)) void midi_on_user(void) {}
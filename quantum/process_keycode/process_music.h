@@ -46,7 +46,8 @@ void music_scale_user(void);
 void music_all_notes_off(void);
 void music_mode_cycle(void);
 
-void music_task(void);
+void     music_task(void);
+uint32_t music_time_until_next(void);
 
 bool music_mask(uint16_t keycode);
 bool music_mask_kb(uint16_t keycode);
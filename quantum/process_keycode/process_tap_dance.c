@@ -158,7 +158,11 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 
             action->state.pressed = record->event.pressed;
             if (record->event.pressed) {
+#ifdef MATRIX_KEY_TIMESTAMPS
+                last_tap_time = record->event.time;
+#else
                 last_tap_time = timer_read();
+#endif
                 process_tap_dance_action_on_each_tap(action);
                 active_td = action->state.finished ? 0 : keycode;
             } else {
@@ -188,6 +192,14 @@ void tap_dance_task(void) {
     }
 }
 
+uint32_t tap_dance_time_until_next(void) {
+    if (!active_td) return UINT32_MAX;
+
+    uint16_t term    = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+    uint16_t elapsed = timer_elapsed(last_tap_time);
+    return elapsed <= term ? term - elapsed + 1 : 0;
+}
+
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
     process_tap_dance_action_on_reset((tap_dance_action_t *)state);
@@ -36,6 +36,10 @@
 #    include "process_joystick.h"
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifdef LEADER_ENABLE
 #    include "process_leader.h"
 #endif
@@ -284,6 +288,10 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_record_processed(keycode, record);
+#endif
+
 #ifdef RGBLIGHT_ENABLE
     if (record->event.pressed) {
         preprocess_rgblight();
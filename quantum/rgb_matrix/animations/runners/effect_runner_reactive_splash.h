@@ -4,26 +4,91 @@
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+// Distance from a hit, at the given tick, beyond which it no longer affects any LED. 0 once the hit has faded out entirely.
+typedef uint16_t (*reactive_splash_reach_f)(uint16_t tick);
+
+bool effect_runner_reactive_splash_reach(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint8_t count = g_last_hit_tracker.count;
+#    if RGB_MATRIX_REACTIVE_GRID
+    static HSV hsv[RGB_MATRIX_LED_COUNT];
+
+    if (!reactive_grid_valid) {
+        reactive_grid_build();
+    }
+    for (uint8_t i = led_min; i < led_max; i++) {
+        hsv[i]   = rgb_matrix_config.hsv;
+        hsv[i].v = 0;
+    }
+
+    // Apply each hit in turn, but only to the LEDs in the grid cells around it which it can still reach
+    for (uint8_t j = start; j < count; j++) {
+        uint16_t tick  = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        uint16_t reach = reach_func ? reach_func(tick) : 256;
+        if (reach == 0) continue;
+
+        uint8_t x      = g_last_hit_tracker.x[j];
+        uint8_t y      = g_last_hit_tracker.y[j];
+        uint8_t radius = reach > 256 ? 255 : reach - 1;
+        uint8_t col0   = qsub8(x, radius) >> REACTIVE_GRID_SHIFT;
+        uint8_t col1   = qadd8(x, radius) >> REACTIVE_GRID_SHIFT;
+        uint8_t row0   = qsub8(y, radius) >> REACTIVE_GRID_SHIFT;
+        uint8_t row1   = qadd8(y, radius) >> REACTIVE_GRID_SHIFT;
+        for (uint8_t row = row0; row <= row1; row++) {
+            uint8_t first = reactive_grid_start[row * REACTIVE_GRID_COLS + col0];
+            uint8_t last  = reactive_grid_start[row * REACTIVE_GRID_COLS + col1 + 1];
+            for (uint8_t k = first; k < last; k++) {
+                uint8_t i = reactive_grid_leds[k];
+                if (i < led_min || i >= led_max) continue;
+                RGB_MATRIX_TEST_LED_FLAGS();
+                int16_t dx   = g_led_config.point[i].x - x;
+                int16_t dy   = g_led_config.point[i].y - y;
+                uint8_t dist = sqrt16(dx * dx + dy * dy);
+                if (dist >= reach) continue;
+                hsv[i] = effect_func(hsv[i], dx, dy, dist, tick);
+            }
+        }
+    }
+
+    rgb_matrix_batch_t batch = {0};
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        hsv[i].v = scale8(hsv[i].v, rgb_matrix_config.hsv.v);
+        rgb_matrix_batch_add(&batch, i, hsv[i]);
+    }
+#    else
+    rgb_matrix_batch_t batch = {0};
+    uint16_t           reach[LED_HITS_TO_REMEMBER];
+    uint16_t           tick[LED_HITS_TO_REMEMBER];
+
+    // Work out once per frame how far each hit can still reach, rather than for every LED
+    for (uint8_t j = start; j < count; j++) {
+        tick[j]  = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        reach[j] = reach_func ? reach_func(tick[j]) : 256;
+    }
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         HSV hsv = rgb_matrix_config.hsv;
         hsv.v   = 0;
         for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+            if (abs(dx) >= reach[j] || abs(dy) >= reach[j]) continue;
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            if (dist >= reach[j]) continue;
+            hsv = effect_func(hsv, dx, dy, dist, tick[j]);
         }
-        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
-        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        rgb_matrix_batch_add(&batch, i, hsv);
     }
+#    endif
+    rgb_matrix_batch_flush(&batch);
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_reach(start, params, effect_func, NULL);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -39,6 +39,85 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Batched counterpart of rgb_matrix_hsv_to_rgb(), for keyboards which adjust colors before they are converted
+__attribute__((weak)) void rgb_matrix_adjust_hsv_batch(HSV *hsv, uint8_t count) {}
+
+void rgb_matrix_batch_add(rgb_matrix_batch_t *batch, uint8_t index, HSV hsv) {
+    batch->index[batch->count] = index;
+    batch->hsv[batch->count]   = hsv;
+    if (++batch->count == RGB_MATRIX_BATCH_SIZE) {
+        rgb_matrix_batch_flush(batch);
+    }
+}
+
+void rgb_matrix_batch_flush(rgb_matrix_batch_t *batch) {
+    RGB rgb[RGB_MATRIX_BATCH_SIZE];
+    rgb_matrix_adjust_hsv_batch(batch->hsv, batch->count);
+    hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        rgb_matrix_set_color(batch->index[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    batch->count = 0;
+}
+
+static led_geometry_t rgb_matrix_compute_led_geometry(uint8_t index) {
+    int16_t dx = g_led_config.point[index].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[index].y - k_rgb_matrix_center.y;
+    return (led_geometry_t){.dist = sqrt16(dx * dx + dy * dy), .angle = atan2_8(dy, dx)};
+}
+
+#if RGB_MATRIX_GEOMETRY_CACHE
+static led_geometry_t led_geometry[RGB_MATRIX_LED_COUNT];
+static bool           led_geometry_valid = false;
+#endif
+
+led_geometry_t rgb_matrix_led_geometry(uint8_t index) {
+#if RGB_MATRIX_GEOMETRY_CACHE
+    // The layout and center are fixed, so build the whole table on first use
+    if (!led_geometry_valid) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            led_geometry[i] = rgb_matrix_compute_led_geometry(i);
+        }
+        led_geometry_valid = true;
+    }
+    return led_geometry[index];
+#else
+    return rgb_matrix_compute_led_geometry(index);
+#endif
+}
+
+#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && RGB_MATRIX_REACTIVE_GRID
+// LED indices grouped into cells of the LED coordinate space, one row of cells after another, with the
+// LEDs of each cell in index order. reactive_grid_start[cell] is the first entry of that cell.
+#    define REACTIVE_GRID_SHIFT 5
+#    define REACTIVE_GRID_COLS (256 >> REACTIVE_GRID_SHIFT)
+#    define REACTIVE_GRID_CELLS (REACTIVE_GRID_COLS * REACTIVE_GRID_COLS)
+static uint8_t reactive_grid_leds[RGB_MATRIX_LED_COUNT];
+static uint8_t reactive_grid_start[REACTIVE_GRID_CELLS + 1];
+static bool    reactive_grid_valid = false;
+
+static uint8_t reactive_grid_cell(uint8_t index) {
+    return (g_led_config.point[index].y >> REACTIVE_GRID_SHIFT) * REACTIVE_GRID_COLS + (g_led_config.point[index].x >> REACTIVE_GRID_SHIFT);
+}
+
+static void reactive_grid_build(void) {
+    uint8_t next[REACTIVE_GRID_CELLS];
+
+    memset(reactive_grid_start, 0, sizeof(reactive_grid_start));
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        reactive_grid_start[reactive_grid_cell(i) + 1]++;
+    }
+    for (uint8_t c = 0; c < REACTIVE_GRID_CELLS; c++) {
+        reactive_grid_start[c + 1] += reactive_grid_start[c];
+    }
+    memcpy(next, reactive_grid_start, sizeof(next));
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        reactive_grid_leds[next[reactive_grid_cell(i)]++] = i;
+    }
+    reactive_grid_valid = true;
+}
+#endif
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -247,14 +326,23 @@ static void rgb_task_timers(void) {
 
     // Update double buffer last hit timers
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
+    uint8_t expired = 0;
+    for (uint8_t i = 0; i < last_hit_buffer.count; ++i) {
         if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
+            // Hits are kept oldest first, so these are always at the front
+            expired = i + 1;
             continue;
         }
         last_hit_buffer.tick[i] += deltaTime;
     }
+    if (expired) {
+        uint8_t remaining = last_hit_buffer.count - expired;
+        memmove(&last_hit_buffer.x[0], &last_hit_buffer.x[expired], remaining);
+        memmove(&last_hit_buffer.y[0], &last_hit_buffer.y[expired], remaining);
+        memmove(&last_hit_buffer.tick[0], &last_hit_buffer.tick[expired], remaining * 2); // 16 bit
+        memmove(&last_hit_buffer.index[0], &last_hit_buffer.index[expired], remaining);
+        last_hit_buffer.count = remaining;
+    }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
@@ -350,9 +438,7 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_task_state = SYNCING;
 }
 
-void rgb_matrix_task(void) {
-    rgb_task_timers();
-
+static uint8_t rgb_task_effect(void) {
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -361,7 +447,13 @@ void rgb_matrix_task(void) {
 #endif // RGB_MATRIX_TIMEOUT > 0
                              false;
 
-    uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
+    return suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
+}
+
+void rgb_matrix_task(void) {
+    rgb_task_timers();
+
+    uint8_t effect = rgb_task_effect();
 
     switch (rgb_task_state) {
         case STARTING:
@@ -385,6 +477,22 @@ void rgb_matrix_task(void) {
     }
 }
 
+uint32_t rgb_matrix_time_until_next(void) {
+    if (rgb_task_state != SYNCING) {
+        // Part way through a frame
+        return 0;
+    }
+
+    uint8_t effect = rgb_task_effect();
+    if (effect == RGB_MATRIX_NONE && rgb_last_effect == RGB_MATRIX_NONE && rgb_matrix_config.enable == rgb_last_enable) {
+        // Nothing new to render
+        return UINT32_MAX;
+    }
+
+    uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+    return elapsed < RGB_MATRIX_LED_FLUSH_LIMIT ? RGB_MATRIX_LED_FLUSH_LIMIT - elapsed : 0;
+}
+
 void rgb_matrix_indicators(void) {
     rgb_matrix_indicators_kb();
 }
@@ -90,6 +90,28 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifndef RGB_MATRIX_BATCH_SIZE
+#    define RGB_MATRIX_BATCH_SIZE 16
+#endif
+
+// Keep the distance and angle of every LED from the center in RAM, rather than recomputing them on every frame
+#ifndef RGB_MATRIX_GEOMETRY_CACHE
+#    ifdef __AVR__
+#        define RGB_MATRIX_GEOMETRY_CACHE 0
+#    else
+#        define RGB_MATRIX_GEOMETRY_CACHE 1
+#    endif
+#endif
+
+// Sort the LEDs into a grid by position, so that reactive effects only visit the LEDs a keypress can still reach
+#ifndef RGB_MATRIX_REACTIVE_GRID
+#    ifdef __AVR__
+#        define RGB_MATRIX_REACTIVE_GRID 0
+#    else
+#        define RGB_MATRIX_REACTIVE_GRID 1
+#    endif
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -148,10 +170,27 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+// LED colors staged by an effect, converted and set together
+typedef struct {
+    uint8_t count;
+    uint8_t index[RGB_MATRIX_BATCH_SIZE];
+    HSV     hsv[RGB_MATRIX_BATCH_SIZE];
+} rgb_matrix_batch_t;
+
+RGB  rgb_matrix_hsv_to_rgb(HSV hsv);
+void rgb_matrix_adjust_hsv_batch(HSV *hsv, uint8_t count);
+void rgb_matrix_batch_add(rgb_matrix_batch_t *batch, uint8_t index, HSV hsv);
+void rgb_matrix_batch_flush(rgb_matrix_batch_t *batch);
+
+led_geometry_t rgb_matrix_led_geometry(uint8_t index);
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
 
+// Time until rgb_matrix_task() next has a frame to render, or UINT32_MAX if nothing is pending
+uint32_t rgb_matrix_time_until_next(void);
+
 // This runs after another backlight effect and replaces
 // colors already set
 void rgb_matrix_indicators(void);
@@ -1566,4 +1566,41 @@ uint8_t rgblight_velocikey_match_speed(uint8_t minValue, uint8_t maxValue) {
     return MAX(minValue, maxValue - (maxValue - minValue) * ((float)typing_speed / TYPING_SPEED_MAX_VALUE));
 }
 
-#endif
\ No newline at end of file
+#endif
+
+#ifdef RGBLIGHT_USE_TIMER
+static inline uint32_t rgblight_time_until(uint16_t deadline) {
+    int16_t remaining = (int16_t)(deadline - sync_timer_read());
+    return remaining > 0 ? (uint32_t)remaining : 0;
+}
+#endif
+
+uint32_t rgblight_time_until_next(void) {
+    uint32_t next = UINT32_MAX;
+
+#ifdef RGBLIGHT_USE_TIMER
+    if (rgblight_status.timer_enabled) {
+        // Next animation step
+        next = animation_status.restart ? 0 : rgblight_time_until(animation_status.last_timer);
+    }
+#    ifdef RGBLIGHT_LAYERS
+    if (deferred_set_layer_state) {
+        return 0;
+    }
+#        ifdef RGBLIGHT_LAYER_BLINK
+    if (_blinking_layer_mask != 0) {
+        next = MIN(next, rgblight_time_until(_repeat_timer));
+    }
+#        endif
+#    endif
+#endif
+
+#ifdef VELOCIKEY_ENABLE
+    if (rgblight_velocikey_enabled() && typing_speed > 0) {
+        // Still decaying
+        return 0;
+    }
+#endif
+
+    return next;
+}
@@ -396,6 +396,9 @@ void rgblight_show_solid_color(uint8_t r, uint8_t g, uint8_t b);
 void preprocess_rgblight(void);
 void rgblight_task(void);
 
+// Time until rgblight_task() next has something to do, or UINT32_MAX if nothing is pending
+uint32_t rgblight_time_until_next(void);
+
 #ifdef RGBLIGHT_USE_TIMER
 void rgblight_timer_init(void);
 void rgblight_timer_enable(void);
@@ -0,0 +1,187 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_telemetry.h"
+
+#include <string.h>
+#include "timer.h"
+#include "print.h"
+#include "transaction_id_define.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    include "chibios_config.h"
+#endif
+
+#if defined(PROTOCOL_CHIBIOS) && defined(PORT_SUPPORTS_RT) && (PORT_SUPPORTS_RT == TRUE)
+#    define SPLIT_TELEMETRY_RT_COUNTER
+#endif
+
+typedef struct {
+    split_telemetry_stats_t stats;
+    bool                    last_failed;
+} split_telemetry_t;
+
+static split_telemetry_t telemetry[NUM_TOTAL_TRANSACTIONS];
+
+__attribute__((weak)) uint32_t split_telemetry_timestamp(void) {
+#if defined(SPLIT_TELEMETRY_RT_COUNTER)
+    return chSysGetRealtimeCounterX();
+#else
+    return timer_read32();
+#endif
+}
+
+uint32_t split_telemetry_elapsed_us(uint32_t elapsed) {
+#if defined(SPLIT_TELEMETRY_RT_COUNTER)
+    return RTC2US(REALTIME_COUNTER_CLOCK, elapsed);
+#else
+    return elapsed * 1000;
+#endif
+}
+
+static inline bool split_telemetry_valid(int8_t id) {
+    return id >= 0 && id < NUM_TOTAL_TRANSACTIONS;
+}
+
+void split_telemetry_record_attempt(int8_t id, bool okay, uint16_t bytes) {
+    if (!split_telemetry_valid(id)) {
+        return;
+    }
+
+    split_telemetry_t *entry = &telemetry[id];
+    if (entry->stats.attempts < UINT32_MAX) {
+        entry->stats.attempts++;
+    }
+    if (entry->last_failed && entry->stats.retries < UINT16_MAX) {
+        entry->stats.retries++;
+    }
+    if (okay) {
+        if (entry->stats.bytes <= UINT32_MAX - bytes) {
+            entry->stats.bytes += bytes;
+        }
+    } else if (entry->stats.failures < UINT16_MAX) {
+        entry->stats.failures++;
+    }
+    entry->last_failed = !okay;
+}
+
+void split_telemetry_record_rtt(int8_t id, uint32_t elapsed) {
+    if (!split_telemetry_valid(id)) {
+        return;
+    }
+
+    split_telemetry_stats_t *stats = &telemetry[id].stats;
+    uint32_t                 us    = split_telemetry_elapsed_us(elapsed);
+    if (us > stats->rtt_max) {
+        stats->rtt_max = us < UINT16_MAX ? us : UINT16_MAX;
+    }
+
+    // One bucket for zero, then one per power of two
+    uint8_t bucket = 0;
+    while (us && bucket < SPLIT_TELEMETRY_RTT_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    if (stats->rtt_buckets[bucket] == UINT16_MAX) {
+        // Halve everything to keep the shape of the distribution
+        for (uint8_t i = 0; i < SPLIT_TELEMETRY_RTT_BUCKETS; i++) {
+            stats->rtt_buckets[i] >>= 1;
+        }
+    }
+    stats->rtt_buckets[bucket]++;
+}
+
+void split_telemetry_record_checksum_error(int8_t id) {
+    if (split_telemetry_valid(id) && telemetry[id].stats.checksum_errors < UINT16_MAX) {
+        telemetry[id].stats.checksum_errors++;
+    }
+}
+
+bool split_telemetry_get_stats(int8_t id, split_telemetry_stats_t *stats) {
+    if (!split_telemetry_valid(id)) {
+        return false;
+    }
+    memcpy(stats, &telemetry[id].stats, sizeof(split_telemetry_stats_t));
+    return true;
+}
+
+uint16_t split_telemetry_rtt_percentile(const split_telemetry_stats_t *stats, uint8_t percent) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < SPLIT_TELEMETRY_RTT_BUCKETS; i++) {
+        total += stats->rtt_buckets[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < SPLIT_TELEMETRY_RTT_BUCKETS - 1; i++) {
+        cumulative += stats->rtt_buckets[i];
+        if (cumulative * 100 >= total * percent) {
+            uint16_t limit = i == 0 ? 0 : (((uint32_t)1) << i) - 1;
+            return limit < stats->rtt_max ? limit : stats->rtt_max;
+        }
+    }
+    return stats->rtt_max;
+}
+
+void split_telemetry_reset(void) {
+    memset(telemetry, 0, sizeof(telemetry));
+}
+
+void split_telemetry_print(void) {
+    xprintf("\n\t- Split telemetry (us) -\n");
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        const split_telemetry_stats_t *stats = &telemetry[id].stats;
+        if (stats->attempts == 0) {
+            continue;
+        }
+        xprintf("%2d n=%lu fail=%u retry=%u crc=%u bytes=%lu p50=%u p99=%u max=%u\n", id, (unsigned long)stats->attempts, stats->failures, stats->retries, stats->checksum_errors, (unsigned long)stats->bytes, split_telemetry_rtt_percentile(stats, 50), split_telemetry_rtt_percentile(stats, 99), stats->rtt_max);
+    }
+}
+
+static void split_telemetry_pack16(uint8_t *dest, uint16_t value) {
+    dest[0] = value & 0xFF;
+    dest[1] = (value >> 8) & 0xFF;
+}
+
+static void split_telemetry_pack32(uint8_t *dest, uint32_t value) {
+    split_telemetry_pack16(&dest[0], value & 0xFFFF);
+    split_telemetry_pack16(&dest[2], value >> 16);
+}
+
+bool split_telemetry_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 2 + 2 * SPLIT_TELEMETRY_RTT_BUCKETS || data[0] != SPLIT_TELEMETRY_RAW_HID_ID) {
+        return false;
+    }
+
+    if (data[1] == SPLIT_TELEMETRY_RAW_HID_RESET) {
+        split_telemetry_reset();
+        return true;
+    }
+
+    split_telemetry_stats_t stats;
+    if (!split_telemetry_get_stats(data[1] & ~SPLIT_TELEMETRY_RAW_HID_HISTOGRAM, &stats)) {
+        // Flag the request as unhandled
+        data[0] = 0xFF;
+        return true;
+    }
+
+    if (data[1] & SPLIT_TELEMETRY_RAW_HID_HISTOGRAM) {
+        for (uint8_t i = 0; i < SPLIT_TELEMETRY_RTT_BUCKETS; i++) {
+            split_telemetry_pack16(&data[2 + 2 * i], stats.rtt_buckets[i]);
+        }
+        return true;
+    }
+
+    split_telemetry_pack32(&data[2], stats.attempts);
+    split_telemetry_pack32(&data[6], stats.bytes);
+    split_telemetry_pack16(&data[10], stats.failures);
+    split_telemetry_pack16(&data[12], stats.retries);
+    split_telemetry_pack16(&data[14], stats.checksum_errors);
+    split_telemetry_pack16(&data[16], split_telemetry_rtt_percentile(&stats, 50));
+    split_telemetry_pack16(&data[18], split_telemetry_rtt_percentile(&stats, 99));
+    split_telemetry_pack16(&data[20], stats.rtt_max);
+    return true;
+}
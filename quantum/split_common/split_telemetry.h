@@ -0,0 +1,130 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+    Split link quality counters.
+
+    Every transaction the master runs against the slave is counted against
+    its transaction ID (see transaction_id_define.h): attempts, failures,
+    retries of a transaction which failed on its previous attempt, checksum
+    mismatches in the data it returned, and payload bytes moved. Round trip
+    times are binned into power-of-two microsecond buckets, so that the link
+    can be tuned without storing individual samples.
+*/
+
+// Number of round trip time buckets, the last one also holds anything slower
+#ifndef SPLIT_TELEMETRY_RTT_BUCKETS
+#    define SPLIT_TELEMETRY_RTT_BUCKETS 12
+#endif
+
+// Raw HID command ID, chosen to stay clear of the VIA command range
+#ifndef SPLIT_TELEMETRY_RAW_HID_ID
+#    define SPLIT_TELEMETRY_RAW_HID_ID 0xF2
+#endif
+
+#define SPLIT_TELEMETRY_RAW_HID_HISTOGRAM 0x80
+#define SPLIT_TELEMETRY_RAW_HID_RESET 0xFF
+
+typedef struct {
+    uint32_t attempts;
+    uint32_t bytes;           // payload bytes of successful transactions
+    uint16_t failures;        // saturating
+    uint16_t retries;         // attempts following a failure of the same transaction
+    uint16_t checksum_errors; // data received intact, but not matching its checksum
+    uint16_t rtt_max;         // microseconds, saturating
+    uint16_t rtt_buckets[SPLIT_TELEMETRY_RTT_BUCKETS];
+} split_telemetry_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef SPLIT_TELEMETRY_ENABLE
+
+/**
+ * @brief Read the timestamp counter used for round trip times.
+ *
+ * Uses the realtime counter on ChibiOS ports that provide one and the
+ * millisecond timer elsewhere.
+ */
+uint32_t split_telemetry_timestamp(void);
+
+/**
+ * @brief Convert a difference of split_telemetry_timestamp() values to microseconds.
+ */
+uint32_t split_telemetry_elapsed_us(uint32_t elapsed);
+
+/**
+ * @brief Record an attempt of a transaction.
+ *
+ * @param id The transaction ID
+ * @param okay Whether the transaction completed
+ * @param bytes Payload bytes moved by the transaction
+ */
+void split_telemetry_record_attempt(int8_t id, bool okay, uint16_t bytes);
+
+/**
+ * @brief Record the round trip time of a transaction.
+ *
+ * @param id The transaction ID
+ * @param elapsed Time taken, in split_telemetry_timestamp() units
+ */
+void split_telemetry_record_rtt(int8_t id, uint32_t elapsed);
+
+/**
+ * @brief Record data received from a transaction which didn't match its checksum.
+ */
+void split_telemetry_record_checksum_error(int8_t id);
+
+/**
+ * @brief Get the counters of a transaction since the last reset.
+ *
+ * @return false if id is out of range
+ */
+bool split_telemetry_get_stats(int8_t id, split_telemetry_stats_t *stats);
+
+/**
+ * @brief Get the upper bound, in microseconds, of the bucket holding the given
+ * percentile of a transaction's round trip times.
+ */
+uint16_t split_telemetry_rtt_percentile(const split_telemetry_stats_t *stats, uint8_t percent);
+
+/**
+ * @brief Discard all counters.
+ */
+void split_telemetry_reset(void);
+
+/**
+ * @brief Print the counters of all transactions which were attempted to the console.
+ */
+void split_telemetry_print(void);
+
+/**
+ * @brief Handle a telemetry request received over raw HID.
+ *
+ * Request: [ SPLIT_TELEMETRY_RAW_HID_ID, transaction ID ]. The buffer is
+ * updated in place with the attempts and bytes as little-endian 32-bit
+ * values, followed by the failures, retries, checksum errors, p50, p99 and
+ * maximum round trip time as little-endian 16-bit values, from offset 2.
+ *
+ * Setting SPLIT_TELEMETRY_RAW_HID_HISTOGRAM in the transaction ID returns the
+ * round trip time buckets as little-endian 16-bit values instead. A
+ * transaction ID of SPLIT_TELEMETRY_RAW_HID_RESET clears all counters.
+ *
+ * @return true if the request was a telemetry request
+ */
+bool split_telemetry_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#else
+
+#    define split_telemetry_record_checksum_error(id)
+
+#endif // SPLIT_TELEMETRY_ENABLE
+
+#ifdef __cplusplus
+}
+#endif
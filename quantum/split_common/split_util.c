@@ -18,6 +18,7 @@
 #include "keyboard.h"
 #include "timer.h"
 #include "transport.h"
+#include "transactions.h"
 #include "wait.h"
 #include "debug.h"
 #include "usb_util.h"
@@ -215,6 +216,10 @@ void split_pre_init(void) {
     if (is_keyboard_master()) {
         transport_master_init();
     }
+
+#ifdef SPLIT_ATTENTION_PIN
+    transactions_attention_init();
+#endif
 }
 
 // this code runs after the keyboard is fully initialized
@@ -0,0 +1,7 @@
+split_telemetry_DEFS := -DSPLIT_TELEMETRY_ENABLE
+split_telemetry_INC := $(QUANTUM_PATH)/split_common
+
+split_telemetry_SRC := \
+    $(QUANTUM_PATH)/split_common/tests/split_telemetry.cpp \
+    $(QUANTUM_PATH)/split_common/split_telemetry.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -0,0 +1,127 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_telemetry.h"
+// The transaction IDs are only ever included from C elsewhere
+#define _Static_assert static_assert
+#include "transaction_id_define.h"
+#undef _Static_assert
+}
+
+class SplitTelemetryTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        split_telemetry_reset();
+    }
+};
+
+TEST_F(SplitTelemetryTest, UnusedTransactionReportsNothing) {
+    split_telemetry_stats_t stats;
+    EXPECT_TRUE(split_telemetry_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &stats));
+    EXPECT_EQ(stats.attempts, 0);
+    EXPECT_EQ(split_telemetry_rtt_percentile(&stats, 50), 0);
+}
+
+TEST_F(SplitTelemetryTest, InvalidTransactionIsRejected) {
+    split_telemetry_stats_t stats;
+    split_telemetry_record_attempt(NUM_TOTAL_TRANSACTIONS, true, 1);
+    split_telemetry_record_attempt(-1, true, 1);
+    EXPECT_FALSE(split_telemetry_get_stats(NUM_TOTAL_TRANSACTIONS, &stats));
+    EXPECT_FALSE(split_telemetry_get_stats(-1, &stats));
+}
+
+TEST_F(SplitTelemetryTest, CountsFailuresAndRetries) {
+    split_telemetry_stats_t stats;
+    split_telemetry_record_attempt(GET_SLAVE_MATRIX_DATA, true, 5);
+    split_telemetry_record_attempt(GET_SLAVE_MATRIX_DATA, false, 5);
+    split_telemetry_record_attempt(GET_SLAVE_MATRIX_DATA, false, 5);
+    split_telemetry_record_attempt(GET_SLAVE_MATRIX_DATA, true, 5);
+    split_telemetry_record_attempt(GET_SLAVE_MATRIX_DATA, true, 5);
+
+    split_telemetry_get_stats(GET_SLAVE_MATRIX_DATA, &stats);
+    EXPECT_EQ(stats.attempts, 5);
+    EXPECT_EQ(stats.failures, 2);
+    EXPECT_EQ(stats.retries, 2);
+    EXPECT_EQ(stats.bytes, 15); // only successful attempts move data
+}
+
+TEST_F(SplitTelemetryTest, TransactionsAreIndependent) {
+    split_telemetry_stats_t stats;
+    split_telemetry_record_attempt(GET_SLAVE_MATRIX_CHECKSUM, false, 1);
+    split_telemetry_record_checksum_error(GET_SLAVE_MATRIX_DATA);
+
+    split_telemetry_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &stats);
+    EXPECT_EQ(stats.failures, 1);
+    EXPECT_EQ(stats.checksum_errors, 0);
+    split_telemetry_get_stats(GET_SLAVE_MATRIX_DATA, &stats);
+    EXPECT_EQ(stats.attempts, 0);
+    EXPECT_EQ(stats.checksum_errors, 1);
+}
+
+TEST_F(SplitTelemetryTest, RoundTripTimesUseMicrosecondBuckets) {
+    split_telemetry_stats_t stats;
+    // The test platform counts milliseconds
+    for (int i = 0; i < 98; i++) {
+        split_telemetry_record_rtt(GET_SLAVE_MATRIX_DATA, 0);
+    }
+    split_telemetry_record_rtt(GET_SLAVE_MATRIX_DATA, 1);
+    split_telemetry_record_rtt(GET_SLAVE_MATRIX_DATA, 100);
+
+    split_telemetry_get_stats(GET_SLAVE_MATRIX_DATA, &stats);
+    EXPECT_EQ(stats.rtt_buckets[0], 98);
+    EXPECT_EQ(stats.rtt_buckets[10], 1); // [512, 1024)
+    EXPECT_EQ(stats.rtt_buckets[SPLIT_TELEMETRY_RTT_BUCKETS - 1], 1);
+    EXPECT_EQ(stats.rtt_max, UINT16_MAX);
+    EXPECT_EQ(split_telemetry_rtt_percentile(&stats, 50), 0);
+    EXPECT_EQ(split_telemetry_rtt_percentile(&stats, 99), 1023);
+}
+
+TEST_F(SplitTelemetryTest, RawHidReportsCounters) {
+    uint8_t data[32] = {SPLIT_TELEMETRY_RAW_HID_ID, GET_SLAVE_MATRIX_DATA};
+    split_telemetry_record_attempt(GET_SLAVE_MATRIX_DATA, false, 0);
+    split_telemetry_record_attempt(GET_SLAVE_MATRIX_DATA, true, 0x1234);
+    split_telemetry_record_checksum_error(GET_SLAVE_MATRIX_DATA);
+
+    EXPECT_TRUE(split_telemetry_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[2], 2); // attempts
+    EXPECT_EQ(data[6], 0x34);
+    EXPECT_EQ(data[7], 0x12); // bytes
+    EXPECT_EQ(data[10], 1);   // failures
+    EXPECT_EQ(data[12], 1);   // retries
+    EXPECT_EQ(data[14], 1);   // checksum errors
+}
+
+TEST_F(SplitTelemetryTest, RawHidReportsHistogram) {
+    uint8_t data[32] = {SPLIT_TELEMETRY_RAW_HID_ID, SPLIT_TELEMETRY_RAW_HID_HISTOGRAM | GET_SLAVE_MATRIX_DATA};
+    split_telemetry_record_rtt(GET_SLAVE_MATRIX_DATA, 0);
+    split_telemetry_record_rtt(GET_SLAVE_MATRIX_DATA, 0);
+
+    EXPECT_TRUE(split_telemetry_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[2], 2);
+    EXPECT_EQ(data[3], 0);
+    EXPECT_EQ(data[4], 0);
+}
+
+TEST_F(SplitTelemetryTest, RawHidResetClearsCounters) {
+    uint8_t                 data[32] = {SPLIT_TELEMETRY_RAW_HID_ID, SPLIT_TELEMETRY_RAW_HID_RESET};
+    split_telemetry_stats_t stats;
+    split_telemetry_record_attempt(GET_SLAVE_MATRIX_DATA, true, 1);
+
+    EXPECT_TRUE(split_telemetry_raw_hid_receive(data, sizeof(data)));
+    split_telemetry_get_stats(GET_SLAVE_MATRIX_DATA, &stats);
+    EXPECT_EQ(stats.attempts, 0);
+}
+
+TEST_F(SplitTelemetryTest, RawHidRejectsUnknownTransaction) {
+    uint8_t data[32] = {SPLIT_TELEMETRY_RAW_HID_ID, 0x7F};
+    EXPECT_TRUE(split_telemetry_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[0], 0xFF);
+}
+
+TEST_F(SplitTelemetryTest, RawHidIgnoresOtherCommands) {
+    uint8_t data[32] = {0x01};
+    EXPECT_FALSE(split_telemetry_raw_hid_receive(data, sizeof(data)));
+}
@@ -21,8 +21,20 @@ enum serial_transaction_id {
     I2C_EXECUTE_CALLBACK,
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    GET_BATCH_RESPONSE,
+    EXCHANGE_BATCH,
+#endif // SPLIT_TRANSACTION_BATCH
+
+#ifdef SPLIT_ATTENTION_PIN
+    CMD_ATTENTION_ACK,
+#endif // SPLIT_ATTENTION_PIN
+
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
+#ifdef SPLIT_MATRIX_DELTA
+    GET_SLAVE_MATRIX_DELTA,
+#endif // SPLIT_MATRIX_DELTA
 
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
@@ -83,6 +95,9 @@ enum serial_transaction_id {
     GET_POINTING_CHECKSUM,
     GET_POINTING_DATA,
     PUT_POINTING_CPI,
+#    ifdef SPLIT_POINTING_ACCUMULATE
+    GET_POINTING_MOTION,
+#    endif // SPLIT_POINTING_ACCUMULATE
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
@@ -30,6 +30,7 @@
 #include "transaction_id_define.h"
 #include "split_util.h"
 #include "synchronization_util.h"
+#include "split_telemetry.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -64,6 +65,9 @@
 #ifdef WPM_ENABLE
 #    include "wpm.h"
 #endif
+#ifdef SPLIT_ATTENTION_PIN
+#    include "gpio.h"
+#endif
 
 #define SYNC_TIMER_OFFSET 2
 
@@ -71,6 +75,10 @@
 #    define FORCED_SYNC_THROTTLE_MS 100
 #endif // FORCED_SYNC_THROTTLE_MS
 
+#ifndef SPLIT_ATTENTION_HEARTBEAT_MS
+#    define SPLIT_ATTENTION_HEARTBEAT_MS 100
+#endif // SPLIT_ATTENTION_HEARTBEAT_MS
+
 #define sizeof_member(type, member) sizeof(((type *)NULL)->member)
 
 #define trans_initiator2target_initializer_cb(member, cb) \
@@ -84,9 +92,34 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#ifdef SPLIT_TRANSACTION_BATCH
+static bool transaction_batch_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define transport_execute_batched transaction_batch_execute
+#else // SPLIT_TRANSACTION_BATCH
+#    define transport_execute_batched transport_execute_transaction
+#endif // SPLIT_TRANSACTION_BATCH
+
+#define transport_write_sync(id, data, length) transport_execute_batched(id, data, length, NULL, 0)
+#define transport_read(id, data, length) transport_execute_batched(id, NULL, 0, data, length)
+#define transport_exec(id) transport_execute_batched(id, NULL, 0, NULL, 0)
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+#    ifdef SPLIT_TRANSACTION_BATCH
+#        error "SPLIT_TRANSPORT_ASYNC can't be combined with SPLIT_TRANSACTION_BATCH"
+#    endif // SPLIT_TRANSACTION_BATCH
+// Writes complete in the background, and are collected at the start of the next pass
+#    define transport_write(id, data, length) transport_begin_write(id, data, length)
+#else // SPLIT_TRANSPORT_ASYNC
+#    define transport_write(id, data, length) transport_write_sync(id, data, length)
+#endif // SPLIT_TRANSPORT_ASYNC
+
+#ifdef SPLIT_ATTENTION_PIN
+// Whether the slave's inputs are read on this pass
+static bool attention_service = true;
+#    define attention_skip_reads() (!attention_service)
+#else // SPLIT_ATTENTION_PIN
+#    define attention_skip_reads() (false)
+#endif // SPLIT_ATTENTION_PIN
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -145,11 +178,20 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     } while (0)
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
+    if (attention_skip_reads()) {
+        // Nothing changed on the slave since the last read
+        memcpy(destination, equiv_shmem, length);
+        return true;
+    }
+
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
         okay &= transport_read(trans_id_retrieve, destination, length);
-        okay &= curr_checksum == crc8(equiv_shmem, length);
+        if (okay && curr_checksum != crc8(equiv_shmem, length)) {
+            split_telemetry_record_checksum_error(trans_id_retrieve);
+            okay = false;
+        }
         if (okay) {
             *last_update = timer_read32();
         }
@@ -178,6 +220,137 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_DELTA
+
+#    ifdef SPLIT_TRANSACTION_BATCH
+#        error "SPLIT_MATRIX_DELTA can't be combined with SPLIT_TRANSACTION_BATCH, which already returns the slave matrix on every exchange"
+#    endif // SPLIT_TRANSACTION_BATCH
+
+_Static_assert(SPLIT_MATRIX_DELTA_LOG_SIZE <= 128 && (SPLIT_MATRIX_DELTA_LOG_SIZE & (SPLIT_MATRIX_DELTA_LOG_SIZE - 1)) == 0, "SPLIT_MATRIX_DELTA_LOG_SIZE must be a power of two, up to 128");
+_Static_assert(SPLIT_MATRIX_DELTA_SIZE <= SPLIT_MATRIX_DELTA_LOG_SIZE, "SPLIT_MATRIX_DELTA_SIZE must not exceed SPLIT_MATRIX_DELTA_LOG_SIZE");
+
+// Slave side change log, indexed by sequence number
+static split_matrix_delta_entry_t slave_matrix_log[SPLIT_MATRIX_DELTA_LOG_SIZE];
+static uint8_t                    slave_matrix_log_seq   = 0; // sequence number of the newest entry
+static uint8_t                    slave_matrix_log_count = 0; // number of entries still available
+static uint8_t                    slave_matrix_log_sent  = 0; // sequence number of the newest entry sent to the master
+
+static void slave_matrix_log_changes(const matrix_row_t previous[], const matrix_row_t current[]) {
+#    ifdef MATRIX_KEY_TIMESTAMPS
+    // Capture times are local, convert them to the master's timebase
+    const uint16_t sync_offset = sync_timer_read() - timer_read();
+    const uint8_t  this_hand   = isLeftHand ? 0 : (MATRIX_ROWS) / 2;
+#    endif // MATRIX_KEY_TIMESTAMPS
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        matrix_row_t changes = previous[row] ^ current[row];
+        for (uint8_t col = 0; changes; col++, changes >>= 1) {
+            if (!(changes & 1)) {
+                continue;
+            }
+            split_matrix_delta_entry_t *entry = &slave_matrix_log[++slave_matrix_log_seq % SPLIT_MATRIX_DELTA_LOG_SIZE];
+            entry->row                        = row;
+            entry->col                        = col;
+            entry->pressed                    = (current[row] >> col) & 1;
+#    ifdef MATRIX_KEY_TIMESTAMPS
+            entry->time = matrix_get_key_time(this_hand + row, col) + sync_offset;
+#    endif // MATRIX_KEY_TIMESTAMPS
+            if (slave_matrix_log_count < SPLIT_MATRIX_DELTA_LOG_SIZE) {
+                slave_matrix_log_count++;
+            }
+        }
+    }
+}
+
+static void slave_matrix_delta_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t               ack     = *(const uint8_t *)initiator2target_buffer;
+    const uint8_t               pending = slave_matrix_log_seq - ack;
+    split_slave_matrix_delta_t *delta   = (split_slave_matrix_delta_t *)target2initiator_buffer;
+
+    memset(delta, 0, sizeof(split_slave_matrix_delta_t));
+    delta->payload.matrix_checksum = split_shmem->smatrix.checksum;
+    if (pending > slave_matrix_log_count) {
+        delta->payload.seq    = slave_matrix_log_seq;
+        delta->payload.resync = true;
+    } else {
+        delta->payload.count = pending < SPLIT_MATRIX_DELTA_SIZE ? pending : SPLIT_MATRIX_DELTA_SIZE;
+        for (uint8_t i = 0; i < delta->payload.count; i++) {
+            delta->payload.entries[i] = slave_matrix_log[(uint8_t)(ack + 1 + i) % SPLIT_MATRIX_DELTA_LOG_SIZE];
+        }
+        delta->payload.seq  = ack + delta->payload.count;
+        delta->payload.more = delta->payload.count < pending;
+    }
+    slave_matrix_log_sent = delta->payload.seq;
+    delta->checksum = crc8(&delta->payload, sizeof(delta->payload));
+}
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static matrix_row_t        last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-synced matrix
+    static uint8_t             last_seq                       = 0;   // sequence number of the last change applied
+    matrix_row_t               temp_matrix[(MATRIX_ROWS) / 2];
+    split_slave_matrix_delta_t delta;
+
+    if (attention_skip_reads()) {
+        memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+        return true;
+    }
+
+    bool okay = transport_execute_transaction(GET_SLAVE_MATRIX_DELTA, &last_seq, sizeof(last_seq), &delta, sizeof(delta));
+    if (okay && delta.checksum != crc8(&delta.payload, sizeof(delta.payload))) {
+        split_telemetry_record_checksum_error(GET_SLAVE_MATRIX_DELTA);
+        okay = false;
+    }
+    if (okay) {
+#    ifdef MATRIX_KEY_TIMESTAMPS
+        const uint8_t that_hand = isLeftHand ? (MATRIX_ROWS) / 2 : 0;
+#    endif // MATRIX_KEY_TIMESTAMPS
+        bool resync = delta.payload.resync || delta.payload.count > SPLIT_MATRIX_DELTA_SIZE;
+        memcpy(temp_matrix, last_matrix, sizeof(temp_matrix));
+
+        for (uint8_t i = 0; !resync && i < delta.payload.count; i++) {
+            // Entries hold the new state rather than a toggle, so replaying one is harmless
+            const split_matrix_delta_entry_t *entry = &delta.payload.entries[i];
+            const matrix_row_t                bit   = (matrix_row_t)1 << entry->col;
+            if (entry->row >= (MATRIX_ROWS) / 2 || entry->col >= MATRIX_COLS) {
+                resync = true;
+            } else if (((temp_matrix[entry->row] & bit) != 0) != entry->pressed) {
+                temp_matrix[entry->row] ^= bit;
+#    ifdef MATRIX_KEY_TIMESTAMPS
+                matrix_set_key_time(that_hand + entry->row, entry->col, entry->time);
+#    endif // MATRIX_KEY_TIMESTAMPS
+            }
+        }
+
+        // Once caught up, both sides must agree on the whole matrix
+        if (!resync && !delta.payload.more) {
+            resync = crc8(temp_matrix, sizeof(temp_matrix)) != delta.payload.matrix_checksum;
+        }
+
+        if (resync) {
+            uint8_t checksum;
+            okay = transport_read(GET_SLAVE_MATRIX_CHECKSUM, &checksum, sizeof(checksum)) && transport_read(GET_SLAVE_MATRIX_DATA, temp_matrix, sizeof(temp_matrix));
+            if (okay && checksum != crc8(temp_matrix, sizeof(temp_matrix))) {
+                split_telemetry_record_checksum_error(GET_SLAVE_MATRIX_DATA);
+                okay = false;
+            }
+#    ifdef MATRIX_KEY_TIMESTAMPS
+            if (okay) {
+                matrix_stamp_raw_changes(last_matrix, temp_matrix, that_hand);
+            }
+#    endif // MATRIX_KEY_TIMESTAMPS
+        }
+
+        if (okay) {
+            memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
+            last_seq = delta.payload.seq;
+        }
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+#else // SPLIT_MATRIX_DELTA
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -193,17 +366,29 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
     return okay;
 }
 
+#endif // SPLIT_MATRIX_DELTA
+
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_MATRIX_DELTA
+    slave_matrix_log_changes(split_shmem->smatrix.matrix, slave_matrix);
+#endif // SPLIT_MATRIX_DELTA
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
 }
 
+#ifdef SPLIT_MATRIX_DELTA
+#    define TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS [GET_SLAVE_MATRIX_DELTA] = {sizeof_member(split_shared_memory_t, smatrix_ack), offsetof(split_shared_memory_t, smatrix_ack), sizeof_member(split_shared_memory_t, smatrix_delta), offsetof(split_shared_memory_t, smatrix_delta), slave_matrix_delta_handlers_slave},
+#else // SPLIT_MATRIX_DELTA
+#    define TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS
+#endif // SPLIT_MATRIX_DELTA
+
 // clang-format off
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix), \
+    TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -700,6 +885,77 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
+#    ifdef SPLIT_POINTING_ACCUMULATE
+
+#        ifdef SPLIT_TRANSACTION_BATCH
+#            error "SPLIT_POINTING_ACCUMULATE can't be combined with SPLIT_TRANSACTION_BATCH, which returns the slave's pointing report on every exchange"
+#        endif // SPLIT_TRANSACTION_BATCH
+
+// Slave side motion, read from the driver but not yet sent to the master
+static split_pointing_motion_t pointing_pending = {0};
+// Slave side motion last sent to the master, resent until acknowledged
+static split_pointing_motion_t pointing_sent = {0};
+
+static void pointing_motion_merge(split_pointing_motion_t *motion, const split_pointing_motion_t *newer) {
+    motion->x       = pointing_device_motion_add(motion->x, newer->x);
+    motion->y       = pointing_device_motion_add(motion->y, newer->y);
+    motion->h       = pointing_device_motion_add(motion->h, newer->h);
+    motion->v       = pointing_device_motion_add(motion->v, newer->v);
+    motion->buttons = newer->buttons;
+}
+
+// Whether the slave has motion or a button change the master hasn't been sent yet
+static bool pointing_motion_pending(void) {
+    return pointing_pending.x || pointing_pending.y || pointing_pending.h || pointing_pending.v || pointing_pending.buttons != pointing_sent.buttons;
+}
+
+static void pointing_motion_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t                  ack  = *(const uint8_t *)initiator2target_buffer;
+    split_slave_pointing_motion_t *sync = (split_slave_pointing_motion_t *)target2initiator_buffer;
+
+    if (ack != pointing_sent.seq) {
+        // The master never got the last motion sent, so resend it along with anything newer
+        pointing_motion_merge(&pointing_sent, &pointing_pending);
+    } else if (pointing_motion_pending()) {
+        // Otherwise the acknowledged sequence number is sent again, which the master ignores
+        const uint8_t seq = pointing_sent.seq + 1;
+        pointing_sent     = pointing_pending;
+        pointing_sent.seq = seq;
+    }
+    pointing_pending.x = pointing_pending.y = pointing_pending.h = pointing_pending.v = 0;
+
+    sync->motion   = pointing_sent;
+    sync->checksum = crc8(&sync->motion, sizeof(split_pointing_motion_t));
+}
+
+static bool pointing_motion_read(void) {
+    static uint8_t                last_seq = 0; // sequence number of the last motion applied
+    split_slave_pointing_motion_t sync;
+
+    if (attention_skip_reads()) {
+        return true;
+    }
+
+    bool okay = transport_execute_transaction(GET_POINTING_MOTION, &last_seq, sizeof(last_seq), &sync, sizeof(sync));
+    if (okay && sync.checksum != crc8(&sync.motion, sizeof(split_pointing_motion_t))) {
+        split_telemetry_record_checksum_error(GET_POINTING_MOTION);
+        okay = false;
+    }
+    if (okay && sync.motion.seq != last_seq) {
+        last_seq = sync.motion.seq;
+        pointing_device_add_shared_motion(sync.motion.buttons, sync.motion.x, sync.motion.y, sync.motion.h, sync.motion.v);
+    }
+    return okay;
+}
+
+#        define TRANSACTIONS_POINTING_MOTION_REGISTRATIONS [GET_POINTING_MOTION] = {sizeof_member(split_shared_memory_t, pointing_ack), offsetof(split_shared_memory_t, pointing_ack), sizeof_member(split_shared_memory_t, pointing_motion), offsetof(split_shared_memory_t, pointing_motion), pointing_motion_handlers_slave},
+
+#    else // SPLIT_POINTING_ACCUMULATE
+
+#        define TRANSACTIONS_POINTING_MOTION_REGISTRATIONS
+
+#    endif // SPLIT_POINTING_ACCUMULATE
+
 static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
 #    if defined(POINTING_DEVICE_LEFT)
     if (is_keyboard_left()) {
@@ -710,12 +966,16 @@ static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t
         return true;
     }
 #    endif
+    static uint16_t last_cpi = 0;
+    uint16_t        temp_cpi;
+#    ifdef SPLIT_POINTING_ACCUMULATE
+    bool okay = pointing_motion_read();
+#    else
     static uint32_t last_update = 0;
-    static uint16_t last_cpi    = 0;
     report_mouse_t  temp_state;
-    uint16_t        temp_cpi;
     bool            okay = read_if_checksum_mismatch(GET_POINTING_CHECKSUM, GET_POINTING_DATA, &last_update, &temp_state, &split_shmem->pointing.report, sizeof(temp_state));
     if (okay) pointing_device_set_shared_report(temp_state);
+#    endif // SPLIT_POINTING_ACCUMULATE
     temp_cpi = pointing_device_get_shared_cpi();
     if (temp_cpi && last_cpi != temp_cpi) {
         split_shmem->pointing.cpi = temp_cpi;
@@ -763,13 +1023,20 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     pointing.checksum = crc8(&pointing.report, sizeof(report_mouse_t));
 
     split_shared_memory_lock();
+#    ifdef SPLIT_POINTING_ACCUMULATE
+    // Add to whatever the master hasn't collected yet, rather than replacing it
+    if (pointing.report.x || pointing.report.y || pointing.report.h || pointing.report.v || pointing.report.buttons != pointing_pending.buttons) {
+        const split_pointing_motion_t sample = {.buttons = pointing.report.buttons, .x = pointing.report.x, .y = pointing.report.y, .h = pointing.report.h, .v = pointing.report.v};
+        pointing_motion_merge(&pointing_pending, &sample);
+    }
+#    endif // SPLIT_POINTING_ACCUMULATE
     memcpy(&split_shmem->pointing, &pointing, sizeof(split_slave_pointing_sync_t));
     split_shared_memory_unlock();
 }
 
 #    define TRANSACTIONS_POINTING_MASTER() TRANSACTION_HANDLER_MASTER(pointing)
 #    define TRANSACTIONS_POINTING_SLAVE() TRANSACTION_HANDLER_SLAVE(pointing)
-#    define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_CHECKSUM] = trans_target2initiator_initializer(pointing.checksum), [GET_POINTING_DATA] = trans_target2initiator_initializer(pointing.report), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi),
+#    define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_CHECKSUM] = trans_target2initiator_initializer(pointing.checksum), [GET_POINTING_DATA] = trans_target2initiator_initializer(pointing.report), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi), TRANSACTIONS_POINTING_MOTION_REGISTRATIONS
 
 #else // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
@@ -908,6 +1175,290 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Attention
+
+#ifdef SPLIT_ATTENTION_PIN
+
+#    ifdef SPLIT_TRANSACTION_BATCH
+#        error "SPLIT_ATTENTION_PIN can't be combined with SPLIT_TRANSACTION_BATCH, which exchanges the slave's state on every scan"
+#    endif // SPLIT_TRANSACTION_BATCH
+
+// Slave side, set when the inputs changed since the master last acknowledged them
+static volatile bool attention_pending = true;
+
+static bool attention_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t last_service = 0;
+    if (!attention_service) {
+        // The heartbeat catches anything missed, and keeps the connection check working
+        attention_service = !gpio_read_pin(SPLIT_ATTENTION_PIN) || !is_transport_connected() || timer_elapsed32(last_service) >= SPLIT_ATTENTION_HEARTBEAT_MS;
+        if (!attention_service) {
+            return true;
+        }
+    }
+
+    // Acknowledge before reading, so that anything changing during the reads raises attention again
+    bool okay = transport_exec(CMD_ATTENTION_ACK);
+    if (okay) {
+        last_service = timer_read32();
+    }
+    return okay;
+}
+
+static void attention_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t last_checksums[3] = {0};
+    uint8_t        checksums[3]      = {split_shmem->smatrix.checksum};
+#    ifdef ENCODER_ENABLE
+    checksums[1] = split_shmem->encoders.checksum;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    checksums[2] = split_shmem->pointing.checksum;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+
+    if (memcmp(checksums, last_checksums, sizeof(checksums)) != 0) {
+        memcpy(last_checksums, checksums, sizeof(checksums));
+        attention_pending = true;
+    }
+#    ifdef SPLIT_MATRIX_DELTA
+    // Hold attention until the whole change log has been fetched
+    if (slave_matrix_log_seq != slave_matrix_log_sent) {
+        attention_pending = true;
+    }
+#    endif // SPLIT_MATRIX_DELTA
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE) && defined(SPLIT_POINTING_ACCUMULATE)
+    // Motion is only reported while it moves, so hold attention until it has been collected
+    if (pointing_motion_pending() || split_shmem->pointing_ack != pointing_sent.seq) {
+        attention_pending = true;
+    }
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE) && defined(SPLIT_POINTING_ACCUMULATE)
+
+    // Active low
+    gpio_write_pin(SPLIT_ATTENTION_PIN, !attention_pending);
+}
+
+static void attention_handlers_slave_ack(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    attention_pending = false;
+    gpio_write_pin_high(SPLIT_ATTENTION_PIN);
+}
+
+void transactions_attention_init(void) {
+    if (is_keyboard_master()) {
+        gpio_set_pin_input_high(SPLIT_ATTENTION_PIN);
+    } else {
+        gpio_set_pin_output(SPLIT_ATTENTION_PIN);
+        gpio_write_pin_low(SPLIT_ATTENTION_PIN);
+    }
+}
+
+#    define TRANSACTIONS_ATTENTION_MASTER() TRANSACTION_HANDLER_MASTER(attention)
+#    define TRANSACTIONS_ATTENTION_SERVICED() (attention_service = false)
+#    define TRANSACTIONS_ATTENTION_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(attention)
+#    define TRANSACTIONS_ATTENTION_REGISTRATIONS [CMD_ATTENTION_ACK] = trans_initiator2target_cb(attention_handlers_slave_ack),
+
+#else // SPLIT_ATTENTION_PIN
+
+#    define TRANSACTIONS_ATTENTION_MASTER()
+#    define TRANSACTIONS_ATTENTION_SERVICED()
+#    define TRANSACTIONS_ATTENTION_SLAVE()
+#    define TRANSACTIONS_ATTENTION_REGISTRATIONS
+
+#endif // SPLIT_ATTENTION_PIN
+
+////////////////////////////////////////////////////
+// Batched transactions
+
+#ifdef SPLIT_TRANSACTION_BATCH
+
+#    ifdef USE_I2C
+#        error "SPLIT_TRANSACTION_BATCH is only supported by the serial transport"
+#    endif // USE_I2C
+
+_Static_assert(sizeof(split_batch_frame_t) <= UINT8_MAX, "SPLIT_TRANSACTION_BATCH_SIZE must fit in a single transaction buffer");
+
+static bool    batch_active = false; // writes are being staged by transactions_master()
+static int8_t  batch_order[NUM_TOTAL_TRANSACTIONS]; // IDs of the staged writes, in the order they were written
+static uint8_t batch_count  = 0;
+static uint8_t batch_length = 0;
+
+static bool transaction_batch_is_staged(int8_t id) {
+    for (uint8_t i = 0; i < batch_count; i++) {
+        if (batch_order[i] == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool transaction_batch_is_response(int8_t id) {
+    switch (id) {
+        case GET_SLAVE_MATRIX_CHECKSUM:
+        case GET_SLAVE_MATRIX_DATA:
+#    ifdef ENCODER_ENABLE
+        case GET_ENCODERS_CHECKSUM:
+        case GET_ENCODERS_DATA:
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+        case GET_POINTING_CHECKSUM:
+        case GET_POINTING_DATA:
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Send all staged writes in a single exchange, and receive the slave's
+ * matrix, encoder and pointing state in return.
+ *
+ * The frame has a fixed size, so scans with nothing staged only read the
+ * slave's state instead.
+ */
+static bool transaction_batch_flush(void) {
+    bool okay;
+    if (batch_count) {
+#    ifndef DISABLE_SYNC_TIMER
+        if (transaction_batch_is_staged(PUT_SYNC_TIMER)) {
+            // Staged on the previous scan, so stamp it again for when it's actually sent
+            split_shmem->sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
+        }
+#    endif // DISABLE_SYNC_TIMER
+
+        // Pack the staged buffers in the order they were written, so the slave applies them in that order too
+        split_batch_frame_t *frame = &split_shmem->batch_frame;
+        uint8_t             *data  = frame->data;
+        for (uint8_t i = 0; i < batch_count; i++) {
+            split_transaction_desc_t *trans = &split_transaction_table[batch_order[i]];
+            *data++                         = batch_order[i];
+            memcpy(data, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+            data += trans->initiator2target_buffer_size;
+        }
+        frame->length   = batch_length;
+        frame->checksum = crc8(&frame->length, sizeof(frame->length));
+
+        // Both buffers are used in place
+        okay = transport_execute_transaction(EXCHANGE_BATCH, NULL, 0, NULL, 0);
+    } else {
+        okay = transport_execute_transaction(GET_BATCH_RESPONSE, NULL, 0, NULL, 0);
+    }
+
+    // Failed writes stay staged, and are sent again with the next batch
+    if (!okay) {
+        return false;
+    }
+    batch_count  = 0;
+    batch_length = 0;
+
+    // Make the slave's state available to the GET_* transactions
+    split_batch_response_t *response = &split_shmem->batch_response;
+    memcpy(&split_shmem->smatrix, &response->smatrix, sizeof(split_slave_matrix_sync_t));
+#    ifdef ENCODER_ENABLE
+    memcpy(&split_shmem->encoders, &response->encoders, sizeof(split_slave_encoder_sync_t));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    split_shmem->pointing.checksum = response->pointing_checksum;
+    memcpy(&split_shmem->pointing.report, &response->pointing_report, sizeof(report_mouse_t));
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    return true;
+}
+
+/**
+ * @brief Stand-in for transport_execute_transaction() while the sync handlers
+ * are run. Writes are staged into their shared memory buffers, and reads of
+ * the slave's state are served from the last batch response.
+ */
+static bool transaction_batch_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (!batch_active) {
+        return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (transaction_batch_is_response(id)) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+        return true;
+    }
+
+    if (trans->target2initiator_buffer_size > 0 || trans->initiator2target_buffer_size >= SPLIT_TRANSACTION_BATCH_SIZE) {
+        // Can't be batched, keep the original ordering by sending everything staged so far first
+        return transaction_batch_flush() && transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    }
+
+    if (!transaction_batch_is_staged(id)) {
+        // One byte for the ID, followed by the buffer
+        if (batch_length + 1 + trans->initiator2target_buffer_size > SPLIT_TRANSACTION_BATCH_SIZE && !transaction_batch_flush()) {
+            return false;
+        }
+        batch_order[batch_count++] = id;
+        batch_length += 1 + trans->initiator2target_buffer_size;
+    }
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+    return true;
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    return transaction_batch_flush();
+}
+
+static void batch_response_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Reply with everything the master would otherwise read one by one
+    split_batch_response_t *response = &split_shmem->batch_response;
+    memcpy(&response->smatrix, &split_shmem->smatrix, sizeof(split_slave_matrix_sync_t));
+#    ifdef ENCODER_ENABLE
+    memcpy(&response->encoders, &split_shmem->encoders, sizeof(split_slave_encoder_sync_t));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    response->pointing_checksum = split_shmem->pointing.checksum;
+    memcpy(&response->pointing_report, &split_shmem->pointing.report, sizeof(report_mouse_t));
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+}
+
+static void batch_exchange_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Unpack each staged buffer as if its own transaction had been received, in the order the master wrote them
+    const split_batch_frame_t *frame     = &split_shmem->batch_frame;
+    const uint8_t             *data      = frame->data;
+    uint8_t                    remaining = frame->length;
+    if (crc8(&frame->length, sizeof(frame->length)) != frame->checksum || remaining > SPLIT_TRANSACTION_BATCH_SIZE) {
+        remaining = 0;
+    }
+    while (remaining > 0) {
+        int8_t id = (int8_t)*data++;
+        remaining--;
+        if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) {
+            break;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (trans->initiator2target_buffer_size > remaining) {
+            break;
+        }
+        memcpy(split_trans_initiator2target_buffer(trans), data, trans->initiator2target_buffer_size);
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+        data += trans->initiator2target_buffer_size;
+        remaining -= trans->initiator2target_buffer_size;
+    }
+
+    batch_response_handlers_slave(initiator2target_buffer_size, initiator2target_buffer, target2initiator_buffer_size, target2initiator_buffer);
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [GET_BATCH_RESPONSE] = trans_target2initiator_initializer_cb(batch_response, batch_response_handlers_slave), \
+    [EXCHANGE_BATCH]     = { sizeof_member(split_shared_memory_t, batch_frame), offsetof(split_shared_memory_t, batch_frame), sizeof_member(split_shared_memory_t, batch_response), offsetof(split_shared_memory_t, batch_response), batch_exchange_handlers_slave },
+// clang-format on
+
+#else // SPLIT_TRANSACTION_BATCH
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCH
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -919,6 +1470,8 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // USE_I2C
 
     // clang-format off
+    TRANSACTIONS_BATCH_REGISTRATIONS
+    TRANSACTIONS_ATTENTION_REGISTRATIONS
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
@@ -948,7 +1501,8 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
-bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static bool transactions_master_handlers(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_ATTENTION_MASTER();
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -968,9 +1522,27 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_ATTENTION_SERVICED();
     return true;
 }
 
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    // Exchange the writes staged on the previous scan for the slave's current state
+    TRANSACTIONS_BATCH_MASTER();
+    batch_active = true;
+    bool okay    = transactions_master_handlers(master_matrix, slave_matrix);
+    batch_active = false;
+    return okay;
+#elif defined(SPLIT_TRANSPORT_ASYNC)
+    // The last writes of the previous pass may still be running
+    bool okay = transport_finish_writes();
+    return transactions_master_handlers(master_matrix, slave_matrix) && okay;
+#else  // SPLIT_TRANSACTION_BATCH
+    return transactions_master_handlers(master_matrix, slave_matrix);
+#endif // SPLIT_TRANSACTION_BATCH
+}
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
@@ -991,6 +1563,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_HAPTIC_SLAVE();
     TRANSACTIONS_ACTIVITY_SLAVE();
     TRANSACTIONS_DETECTED_OS_SLAVE();
+    TRANSACTIONS_ATTENTION_SLAVE();
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -1029,13 +1602,14 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     // * send the request data
     // * execute RPC callback
     // * retrieve the response data
-    if (!transport_write(PUT_RPC_INFO, &info, sizeof(info))) {
+    // Each step must have landed before the next one, so don't leave writes running in the background
+    if (!transport_write_sync(PUT_RPC_INFO, &info, sizeof(info))) {
         return false;
     }
-    if (!transport_write(PUT_RPC_REQ_DATA, initiator2target_buffer, initiator2target_buffer_size)) {
+    if (!transport_write_sync(PUT_RPC_REQ_DATA, initiator2target_buffer, initiator2target_buffer_size)) {
         return false;
     }
-    if (!transport_write(EXECUTE_RPC, &transaction_id, sizeof(transaction_id))) {
+    if (!transport_write_sync(EXECUTE_RPC, &transaction_id, sizeof(transaction_id))) {
         return false;
     }
     if (!transport_read(GET_RPC_RESP_DATA, target2initiator_buffer, target2initiator_buffer_size)) {
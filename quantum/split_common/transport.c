@@ -21,6 +21,21 @@
 #include "transport.h"
 #include "transaction_id_define.h"
 #include "atomic_util.h"
+#include "task_profiling.h"
+#include "split_telemetry.h"
+#include "split_util.h"
+
+#ifdef SPLIT_TELEMETRY_ENABLE
+static void transport_record_attempt(int8_t id, bool okay) {
+    // Buffers are always sent in full, whatever the requested lengths
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    split_telemetry_record_attempt(id, okay, trans->initiator2target_buffer_size + trans->target2initiator_buffer_size);
+}
+#endif // SPLIT_TELEMETRY_ENABLE
+
+#if defined(SPLIT_TRANSPORT_ASYNC) && (defined(USE_I2C) || !(defined(SERIAL_DRIVER_USART) || defined(SERIAL_DRIVER_VENDOR)))
+#    error "SPLIT_TRANSPORT_ASYNC requires the usart or vendor serial driver"
+#endif
 
 #ifdef USE_I2C
 
@@ -59,7 +74,7 @@ i2c_status_t transport_trigger_callback(int8_t id) {
     return i2c_write_register(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, SLAVE_I2C_TIMEOUT);
 }
 
-bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+static bool transport_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     i2c_status_t              status;
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
@@ -100,7 +115,93 @@ void transport_slave_init(void) {
     soft_serial_target_init();
 }
 
-bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+#    ifdef SPLIT_TRANSPORT_ASYNC
+static bool    background_okay = true; // no background write failed since transport_finish_writes()
+static int8_t  background_ids[SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE]; // the writes queued in the background, oldest first
+static uint8_t background_tail  = 0;
+static uint8_t background_count = 0;
+
+static void transport_collect_oldest(void) {
+    bool okay = soft_serial_transaction_end();
+#        ifdef SPLIT_TELEMETRY_ENABLE
+    transport_record_attempt(background_ids[background_tail], okay);
+#        endif // SPLIT_TELEMETRY_ENABLE
+    background_tail = (background_tail + 1) % SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE;
+    background_count--;
+    background_okay &= okay;
+}
+
+static void transport_collect_background(void) {
+    while (background_count > 0) {
+        transport_collect_oldest();
+    }
+}
+
+static bool transport_background_uses(const split_transaction_desc_t *trans) {
+    for (uint8_t i = 0; i < background_count; i++) {
+        const split_transaction_desc_t *queued = &split_transaction_table[background_ids[(background_tail + i) % SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE]];
+        if (queued->initiator2target_offset < trans->initiator2target_offset + trans->initiator2target_buffer_size && trans->initiator2target_offset < queued->initiator2target_offset + queued->initiator2target_buffer_size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool transport_queue(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, uint8_t attempts) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+
+    // A queued write owns its buffer until it has been sent
+    while (background_count > 0 && (background_count >= SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE || transport_background_uses(trans))) {
+        transport_collect_oldest();
+    }
+
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    return soft_serial_transaction_begin(id, attempts);
+}
+
+bool transport_begin_write(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length) {
+    // A failed write is retried by the serial thread before the writes after it, as often as the transaction handlers would
+    if (!transport_queue(id, initiator2target_buf, initiator2target_length, is_transport_connected() ? 10 : 1)) {
+        return false;
+    }
+    background_ids[(background_tail + background_count) % SPLIT_TRANSPORT_ASYNC_QUEUE_SIZE] = id;
+    background_count++;
+    return true;
+}
+
+bool transport_finish_writes(void) {
+    transport_collect_background();
+    bool okay       = background_okay;
+    background_okay = true;
+    return okay;
+}
+
+static bool transport_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+
+    // Runs straight after the writes queued before it, and is retried by the caller like any other transaction
+    if (!transport_queue(id, initiator2target_buf, initiator2target_length, 1)) {
+        return false;
+    }
+    transport_collect_background();
+    if (!soft_serial_transaction_end()) {
+        return false;
+    }
+
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return true;
+}
+#    else // SPLIT_TRANSPORT_ASYNC
+
+static bool transport_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
@@ -118,11 +219,38 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 
     return true;
 }
+#    endif // SPLIT_TRANSPORT_ASYNC
 
 #endif // USE_I2C
 
+static bool transport_execute_recorded(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+#ifdef SPLIT_TELEMETRY_ENABLE
+#    ifdef SPLIT_TRANSPORT_ASYNC
+    // Waiting for the writes queued before it isn't part of the round trip
+    const bool timed = background_count == 0;
+#    else  // SPLIT_TRANSPORT_ASYNC
+    const bool timed = true;
+#    endif // SPLIT_TRANSPORT_ASYNC
+    const uint32_t start = split_telemetry_timestamp();
+    bool           okay  = transport_execute(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    if (okay && timed) {
+        split_telemetry_record_rtt(id, split_telemetry_timestamp() - start);
+    }
+    transport_record_attempt(id, okay);
+    return okay;
+#else
+    return transport_execute(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+#endif // SPLIT_TELEMETRY_ENABLE
+}
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    return transport_execute_recorded(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    return transactions_master(master_matrix, slave_matrix);
+    bool okay;
+    TASK_PROFILE(TASK_PROFILING_SPLIT_TRANSACTIONS, okay = transactions_master(master_matrix, slave_matrix));
+    return okay;
 }
 
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
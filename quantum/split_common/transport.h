@@ -40,6 +40,13 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+// start a write-only transaction, which completes in the background
+bool transport_begin_write(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length);
+// wait for background writes, returns false if any of them failed since the last call
+bool transport_finish_writes(void);
+#endif // SPLIT_TRANSPORT_ASYNC
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -57,6 +64,37 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_MATRIX_DELTA
+#    ifndef SPLIT_MATRIX_DELTA_SIZE
+#        define SPLIT_MATRIX_DELTA_SIZE 4
+#    endif // SPLIT_MATRIX_DELTA_SIZE
+
+#    ifndef SPLIT_MATRIX_DELTA_LOG_SIZE
+#        define SPLIT_MATRIX_DELTA_LOG_SIZE 16
+#    endif // SPLIT_MATRIX_DELTA_LOG_SIZE
+
+typedef struct _split_matrix_delta_entry_t {
+    uint8_t row;
+    uint8_t col : 7;
+    bool    pressed : 1;
+#    ifdef MATRIX_KEY_TIMESTAMPS
+    uint16_t time; // slave's capture time of the change, in sync timer ticks
+#    endif         // MATRIX_KEY_TIMESTAMPS
+} split_matrix_delta_entry_t;
+
+typedef struct _split_slave_matrix_delta_t {
+    uint8_t checksum;
+    struct {
+        uint8_t                    seq;             // sequence number of the last entry, or of the slave's log on resync
+        uint8_t                    matrix_checksum; // checksum of the slave's matrix with all logged changes applied
+        uint8_t                    count;
+        bool                       more : 1; // further changes are logged after the last entry
+        bool                       resync : 1; // the changes since the acknowledged entry are no longer logged
+        split_matrix_delta_entry_t entries[SPLIT_MATRIX_DELTA_SIZE];
+    } payload;
+} split_slave_matrix_delta_t;
+#endif // SPLIT_MATRIX_DELTA
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -112,7 +150,23 @@ typedef struct _split_slave_pointing_sync_t {
     report_mouse_t report;
     uint16_t       cpi;
 } split_slave_pointing_sync_t;
-#endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+
+#    ifdef SPLIT_POINTING_ACCUMULATE
+typedef struct _split_pointing_motion_t {
+    uint8_t seq; // bumped for each new batch of motion, acknowledged by the master
+    uint8_t buttons;
+    int16_t x;
+    int16_t y;
+    int16_t h;
+    int16_t v;
+} split_pointing_motion_t;
+
+typedef struct _split_slave_pointing_motion_t {
+    uint8_t                 checksum;
+    split_pointing_motion_t motion;
+} split_slave_pointing_motion_t;
+#    endif // SPLIT_POINTING_ACCUMULATE
+#endif     // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
 #if defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
 #    include "haptic.h"
@@ -146,6 +200,29 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSACTION_BATCH
+#    ifndef SPLIT_TRANSACTION_BATCH_SIZE
+#        define SPLIT_TRANSACTION_BATCH_SIZE 64
+#    endif // SPLIT_TRANSACTION_BATCH_SIZE
+
+typedef struct _split_batch_frame_t {
+    uint8_t checksum;
+    uint8_t length;                             // number of bytes of data in use
+    uint8_t data[SPLIT_TRANSACTION_BATCH_SIZE]; // each packed transaction is its ID followed by its buffer, in the order they were written
+} split_batch_frame_t;
+
+typedef struct _split_batch_response_t {
+    split_slave_matrix_sync_t smatrix;
+#    ifdef ENCODER_ENABLE
+    split_slave_encoder_sync_t encoders;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    uint8_t        pointing_checksum;
+    report_mouse_t pointing_report;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+} split_batch_response_t;
+#endif // SPLIT_TRANSACTION_BATCH
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -153,6 +230,11 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_MATRIX_DELTA
+    uint8_t                    smatrix_ack; // sequence number of the last change applied by the master
+    split_slave_matrix_delta_t smatrix_delta;
+#endif // SPLIT_MATRIX_DELTA
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -207,7 +289,11 @@ typedef struct _split_shared_memory_t {
 
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
     split_slave_pointing_sync_t pointing;
-#endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#    ifdef SPLIT_POINTING_ACCUMULATE
+    uint8_t                       pointing_ack; // sequence number of the last motion applied by the master
+    split_slave_pointing_motion_t pointing_motion;
+#    endif // SPLIT_POINTING_ACCUMULATE
+#endif     // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     bool watchdog_pinged;
@@ -230,6 +316,11 @@ typedef struct _split_shared_memory_t {
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+
+#ifdef SPLIT_TRANSACTION_BATCH
+    split_batch_frame_t    batch_frame;
+    split_batch_response_t batch_response;
+#endif // SPLIT_TRANSACTION_BATCH
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
@@ -0,0 +1,193 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "task_profiling.h"
+
+#include <string.h>
+#include "timer.h"
+#include "print.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+// Not every port has a realtime counter, e.g. ARMv6-M parts have no DWT
+#if defined(PROTOCOL_CHIBIOS) && defined(PORT_SUPPORTS_RT) && (PORT_SUPPORTS_RT == TRUE)
+#    define TASK_PROFILING_RT_COUNTER
+#    define TASK_PROFILING_UNITS "cycles"
+#else
+#    define TASK_PROFILING_UNITS "ms"
+#endif
+
+// One bucket for zero, then one per power of two up to 2^31
+#define TASK_PROFILING_BUCKETS 33
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint16_t buckets[TASK_PROFILING_BUCKETS];
+} task_profile_t;
+
+static task_profile_t task_profiles[TASK_PROFILING_STAGE_COUNT];
+
+static const char *const task_profiling_stage_names[TASK_PROFILING_STAGE_COUNT] = {
+    [TASK_PROFILING_KEYBOARD_TASK]      = "keyboard_task",
+    [TASK_PROFILING_MATRIX]             = "matrix_task",
+    [TASK_PROFILING_QUANTUM]            = "quantum_task",
+    [TASK_PROFILING_RGBLIGHT]           = "rgblight_task",
+    [TASK_PROFILING_LED_MATRIX]         = "led_matrix_task",
+    [TASK_PROFILING_RGB_MATRIX]         = "rgb_matrix_task",
+    [TASK_PROFILING_ENCODER]            = "encoder_task",
+    [TASK_PROFILING_POINTING_DEVICE]    = "pointing_device_task",
+    [TASK_PROFILING_OLED]               = "oled_task",
+    [TASK_PROFILING_ST7565]             = "st7565_task",
+    [TASK_PROFILING_SPLIT_TRANSACTIONS] = "split_transactions",
+};
+
+__attribute__((weak)) uint32_t task_profiling_timestamp(void) {
+#if defined(TASK_PROFILING_RT_COUNTER)
+    return chSysGetRealtimeCounterX();
+#else
+    return timer_read32();
+#endif
+}
+
+static uint8_t task_profiling_bucket(uint32_t duration) {
+    uint8_t bucket = 0;
+    while (duration) {
+        duration >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static uint32_t task_profiling_bucket_limit(uint8_t bucket) {
+    if (bucket == 0) {
+        return 0;
+    }
+    if (bucket >= 32) {
+        return UINT32_MAX;
+    }
+    return (((uint32_t)1) << bucket) - 1;
+}
+
+void task_profiling_record(task_profiling_stage_t stage, uint32_t duration) {
+    if (stage >= TASK_PROFILING_STAGE_COUNT) {
+        return;
+    }
+
+    task_profile_t *profile = &task_profiles[stage];
+    if (profile->count == 0 || duration < profile->min) {
+        profile->min = duration;
+    }
+    if (duration > profile->max) {
+        profile->max = duration;
+    }
+    if (profile->count < UINT32_MAX) {
+        profile->count++;
+    }
+
+    uint8_t bucket = task_profiling_bucket(duration);
+    if (profile->buckets[bucket] == UINT16_MAX) {
+        // Halve everything to keep the shape of the distribution
+        for (uint8_t i = 0; i < TASK_PROFILING_BUCKETS; i++) {
+            profile->buckets[i] >>= 1;
+        }
+    }
+    profile->buckets[bucket]++;
+}
+
+static uint32_t task_profiling_percentile(const task_profile_t *profile, uint32_t total, uint8_t percent) {
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < TASK_PROFILING_BUCKETS; i++) {
+        cumulative += profile->buckets[i];
+        if ((uint64_t)cumulative * 100 >= (uint64_t)total * percent) {
+            uint32_t limit = task_profiling_bucket_limit(i);
+            if (limit < profile->min) return profile->min;
+            if (limit > profile->max) return profile->max;
+            return limit;
+        }
+    }
+    return profile->max;
+}
+
+bool task_profiling_get_stats(task_profiling_stage_t stage, task_profiling_stats_t *stats) {
+    if (stage >= TASK_PROFILING_STAGE_COUNT) {
+        return false;
+    }
+
+    const task_profile_t *profile = &task_profiles[stage];
+    memset(stats, 0, sizeof(task_profiling_stats_t));
+    if (profile->count == 0) {
+        return true;
+    }
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < TASK_PROFILING_BUCKETS; i++) {
+        total += profile->buckets[i];
+    }
+
+    stats->count = profile->count;
+    stats->min   = profile->min;
+    stats->max   = profile->max;
+    stats->p50   = task_profiling_percentile(profile, total, 50);
+    stats->p99   = task_profiling_percentile(profile, total, 99);
+    return true;
+}
+
+const char *task_profiling_stage_name(task_profiling_stage_t stage) {
+    if (stage >= TASK_PROFILING_STAGE_COUNT) {
+        return "unknown";
+    }
+    return task_profiling_stage_names[stage];
+}
+
+void task_profiling_reset(void) {
+    memset(task_profiles, 0, sizeof(task_profiles));
+}
+
+void task_profiling_print(void) {
+    task_profiling_stats_t stats;
+
+    xprintf("\n\t- Task profiling (" TASK_PROFILING_UNITS ") -\n");
+    for (uint8_t i = 0; i < TASK_PROFILING_STAGE_COUNT; i++) {
+        task_profiling_get_stats(i, &stats);
+        if (stats.count == 0) {
+            continue;
+        }
+        xprintf("%-22s n=%lu min=%lu p50=%lu p99=%lu max=%lu\n", task_profiling_stage_name(i), (unsigned long)stats.count, (unsigned long)stats.min, (unsigned long)stats.p50, (unsigned long)stats.p99, (unsigned long)stats.max);
+    }
+}
+
+static void task_profiling_pack32(uint8_t *dest, uint32_t value) {
+    dest[0] = value & 0xFF;
+    dest[1] = (value >> 8) & 0xFF;
+    dest[2] = (value >> 16) & 0xFF;
+    dest[3] = (value >> 24) & 0xFF;
+}
+
+bool task_profiling_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 2 + 5 * sizeof(uint32_t) || data[0] != TASK_PROFILING_RAW_HID_ID) {
+        return false;
+    }
+
+    if (data[1] == TASK_PROFILING_RAW_HID_RESET) {
+        task_profiling_reset();
+        return true;
+    }
+
+    task_profiling_stats_t stats;
+    if (!task_profiling_get_stats(data[1], &stats)) {
+        // Flag the request as unhandled
+        data[0] = 0xFF;
+        return true;
+    }
+
+    task_profiling_pack32(&data[2], stats.count);
+    task_profiling_pack32(&data[6], stats.min);
+    task_profiling_pack32(&data[10], stats.max);
+    task_profiling_pack32(&data[14], stats.p50);
+    task_profiling_pack32(&data[18], stats.p99);
+    return true;
+}
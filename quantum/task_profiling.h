@@ -0,0 +1,128 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+    Per-stage execution time histograms for keyboard_task().
+
+    Each instrumented stage records how long it took on every pass through
+    the main loop. Durations are binned into power-of-two buckets so that
+    worst-case behaviour can be reported without storing individual samples.
+
+    Usage example:
+
+        // Original code:
+        rgb_matrix_task();
+
+        // Replace with the following:
+        TASK_PROFILE(TASK_PROFILING_RGB_MATRIX, rgb_matrix_task());
+*/
+
+typedef enum {
+    TASK_PROFILING_KEYBOARD_TASK,
+    TASK_PROFILING_MATRIX,
+    TASK_PROFILING_QUANTUM,
+    TASK_PROFILING_RGBLIGHT,
+    TASK_PROFILING_LED_MATRIX,
+    TASK_PROFILING_RGB_MATRIX,
+    TASK_PROFILING_ENCODER,
+    TASK_PROFILING_POINTING_DEVICE,
+    TASK_PROFILING_OLED,
+    TASK_PROFILING_ST7565,
+    TASK_PROFILING_SPLIT_TRANSACTIONS,
+    TASK_PROFILING_STAGE_COUNT,
+} task_profiling_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t p50;
+    uint32_t p99;
+} task_profiling_stats_t;
+
+// Raw HID command ID, chosen to stay clear of the VIA command range
+#ifndef TASK_PROFILING_RAW_HID_ID
+#    define TASK_PROFILING_RAW_HID_ID 0xF1
+#endif
+
+#define TASK_PROFILING_RAW_HID_RESET 0xFF
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Read the timestamp counter used for profiling.
+ *
+ * Uses the cycle counter on ChibiOS ports that provide one and the millisecond
+ * timer elsewhere. Can be overridden by a keyboard with access to a finer grained counter.
+ */
+uint32_t task_profiling_timestamp(void);
+
+/**
+ * @brief Record the execution time of a stage.
+ *
+ * @param stage The stage which was executed
+ * @param duration Time taken, in task_profiling_timestamp() units
+ */
+void task_profiling_record(task_profiling_stage_t stage, uint32_t duration);
+
+/**
+ * @brief Summarise the samples recorded for a stage since the last reset.
+ *
+ * Percentiles are resolved to the upper bound of the histogram bucket they
+ * fall in, clamped to the observed min and max.
+ *
+ * @return false if stage is out of range
+ */
+bool task_profiling_get_stats(task_profiling_stage_t stage, task_profiling_stats_t *stats);
+
+/**
+ * @brief Get the printable name of a stage.
+ */
+const char *task_profiling_stage_name(task_profiling_stage_t stage);
+
+/**
+ * @brief Discard all recorded samples.
+ */
+void task_profiling_reset(void);
+
+/**
+ * @brief Print the statistics of all stages to the console.
+ */
+void task_profiling_print(void);
+
+/**
+ * @brief Handle a profiling request received over raw HID.
+ *
+ * Request: [ TASK_PROFILING_RAW_HID_ID, stage ]. A stage of
+ * TASK_PROFILING_RAW_HID_RESET clears all samples instead. The buffer is
+ * updated in place with the count, min, max, p50 and p99 of the stage as
+ * little-endian 32-bit values from offset 2, and should then be returned with
+ * raw_hid_send().
+ *
+ * @return true if the request was a profiling request
+ */
+bool task_profiling_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef TASK_PROFILING_ENABLE
+#    define TASK_PROFILE(stage, call)                                                          \
+        do {                                                                                   \
+            const uint32_t task_profiling_start = task_profiling_timestamp();                  \
+            call;                                                                              \
+            task_profiling_record((stage), task_profiling_timestamp() - task_profiling_start); \
+        } while (0)
+#else
+#    define TASK_PROFILE(stage, call) \
+        do {                          \
+            call;                     \
+        } while (0)
+#endif
@@ -0,0 +1,6 @@
+task_profiling_DEFS := -DTASK_PROFILING_ENABLE
+
+task_profiling_SRC := \
+    $(QUANTUM_PATH)/task_profiling/tests/task_profiling.cpp \
+    $(QUANTUM_PATH)/task_profiling.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -0,0 +1,105 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "task_profiling.h"
+}
+
+class TaskProfilingTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        task_profiling_reset();
+    }
+};
+
+TEST_F(TaskProfilingTest, EmptyStageReportsNothing) {
+    task_profiling_stats_t stats;
+    EXPECT_TRUE(task_profiling_get_stats(TASK_PROFILING_MATRIX, &stats));
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_EQ(stats.max, 0);
+}
+
+TEST_F(TaskProfilingTest, InvalidStageIsRejected) {
+    task_profiling_stats_t stats;
+    task_profiling_record(TASK_PROFILING_STAGE_COUNT, 10);
+    EXPECT_FALSE(task_profiling_get_stats(TASK_PROFILING_STAGE_COUNT, &stats));
+}
+
+TEST_F(TaskProfilingTest, TracksMinAndMax) {
+    task_profiling_stats_t stats;
+    task_profiling_record(TASK_PROFILING_RGB_MATRIX, 40);
+    task_profiling_record(TASK_PROFILING_RGB_MATRIX, 7);
+    task_profiling_record(TASK_PROFILING_RGB_MATRIX, 900);
+
+    task_profiling_get_stats(TASK_PROFILING_RGB_MATRIX, &stats);
+    EXPECT_EQ(stats.count, 3);
+    EXPECT_EQ(stats.min, 7);
+    EXPECT_EQ(stats.max, 900);
+}
+
+TEST_F(TaskProfilingTest, PercentilesResolveToBucketLimits) {
+    task_profiling_stats_t stats;
+    // 98 fast passes in the [64, 128) bucket, 2 slow passes in the [4096, 8192) bucket
+    for (int i = 0; i < 98; i++) {
+        task_profiling_record(TASK_PROFILING_KEYBOARD_TASK, 100);
+    }
+    task_profiling_record(TASK_PROFILING_KEYBOARD_TASK, 5000);
+    task_profiling_record(TASK_PROFILING_KEYBOARD_TASK, 6000);
+
+    task_profiling_get_stats(TASK_PROFILING_KEYBOARD_TASK, &stats);
+    EXPECT_EQ(stats.p50, 127);
+    EXPECT_EQ(stats.p99, 6000); // bucket limit clamped to the observed max
+}
+
+TEST_F(TaskProfilingTest, StagesAreIndependent) {
+    task_profiling_stats_t stats;
+    task_profiling_record(TASK_PROFILING_OLED, 12);
+
+    task_profiling_get_stats(TASK_PROFILING_ENCODER, &stats);
+    EXPECT_EQ(stats.count, 0);
+    task_profiling_get_stats(TASK_PROFILING_OLED, &stats);
+    EXPECT_EQ(stats.count, 1);
+}
+
+TEST_F(TaskProfilingTest, SaturatedBucketsKeepDistribution) {
+    task_profiling_stats_t stats;
+    for (uint32_t i = 0; i < 70000; i++) {
+        task_profiling_record(TASK_PROFILING_QUANTUM, 3);
+    }
+    task_profiling_record(TASK_PROFILING_QUANTUM, 1000);
+
+    task_profiling_get_stats(TASK_PROFILING_QUANTUM, &stats);
+    EXPECT_EQ(stats.count, 70001);
+    EXPECT_EQ(stats.p50, 3);
+    EXPECT_EQ(stats.p99, 3);
+    EXPECT_EQ(stats.max, 1000);
+}
+
+TEST_F(TaskProfilingTest, RawHidReportsStage) {
+    uint8_t data[32] = {TASK_PROFILING_RAW_HID_ID, TASK_PROFILING_MATRIX};
+    task_profiling_record(TASK_PROFILING_MATRIX, 0x1234);
+
+    EXPECT_TRUE(task_profiling_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[2], 1); // count
+    EXPECT_EQ(data[6], 0x34);
+    EXPECT_EQ(data[7], 0x12); // min
+    EXPECT_EQ(data[10], 0x34);
+    EXPECT_EQ(data[11], 0x12); // max
+}
+
+TEST_F(TaskProfilingTest, RawHidResetClearsSamples) {
+    uint8_t                data[32] = {TASK_PROFILING_RAW_HID_ID, TASK_PROFILING_RAW_HID_RESET};
+    task_profiling_stats_t stats;
+    task_profiling_record(TASK_PROFILING_MATRIX, 10);
+
+    EXPECT_TRUE(task_profiling_raw_hid_receive(data, sizeof(data)));
+    task_profiling_get_stats(TASK_PROFILING_MATRIX, &stats);
+    EXPECT_EQ(stats.count, 0);
+}
+
+TEST_F(TaskProfilingTest, RawHidIgnoresOtherCommands) {
+    uint8_t data[32] = {0x01};
+    EXPECT_FALSE(task_profiling_raw_hid_receive(data, sizeof(data)));
+}
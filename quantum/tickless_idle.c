@@ -0,0 +1,206 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tickless_idle.h"
+
+#include "timer.h"
+#include "util.h"
+#include "matrix.h"
+#include "action.h"
+#include "action_tapping.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#elif defined(__AVR__)
+#    include <avr/sleep.h>
+#endif
+
+#ifdef COMBO_ENABLE
+#    include "process_combo.h"
+#endif
+#ifdef TAP_DANCE_ENABLE
+#    include "process_tap_dance.h"
+#endif
+#ifdef LEADER_ENABLE
+#    include "leader.h"
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif
+#ifdef LED_MATRIX_ENABLE
+#    include "led_matrix.h"
+#endif
+#ifdef OLED_ENABLE
+#    include "oled_driver.h"
+#endif
+#ifdef WPM_ENABLE
+#    include "wpm.h"
+#endif
+#ifdef RGBLIGHT_ENABLE
+#    include "rgblight.h"
+#endif
+#ifdef BACKLIGHT_ENABLE
+#    include "backlight.h"
+#endif
+#ifdef ENCODER_ENABLE
+#    include "encoder.h"
+#endif
+#ifdef POINTING_DEVICE_ENABLE
+#    include "pointing_device.h"
+#endif
+#ifdef MOUSEKEY_ENABLE
+#    include "mousekey.h"
+#endif
+#ifdef HAPTIC_ENABLE
+#    include "haptic.h"
+#endif
+#ifdef AUDIO_ENABLE
+#    include "audio.h"
+#    include "process_music.h"
+#endif
+#ifdef CAPS_WORD_ENABLE
+#    include "caps_word.h"
+#endif
+
+__attribute__((weak)) uint32_t tickless_idle_time_until_next_user(uint32_t next) {
+    return next;
+}
+
+__attribute__((weak)) uint32_t tickless_idle_time_until_next_kb(uint32_t next) {
+    return tickless_idle_time_until_next_user(next);
+}
+
+uint32_t tickless_idle_time_until_next(void) {
+    uint32_t next = TICKLESS_IDLE_NO_DEADLINE;
+
+#if defined(SEQUENCER_ENABLE) || defined(KEY_OVERRIDE_ENABLE) || defined(AUTO_SHIFT_ENABLE) || defined(SECURE_ENABLE) || defined(DIP_SWITCH_ENABLE) || defined(SPLIT_WATCHDOG_ENABLE) || defined(ST7565_ENABLE) || defined(PS2_MOUSE_ENABLE) || defined(MIDI_ENABLE) || defined(JOYSTICK_ENABLE) || defined(BLUETOOTH_ENABLE) || defined(OS_DETECTION_ENABLE)
+    // These features are polled from keyboard_task() and can't report when they are next due
+    next = 0;
+#endif
+
+#ifndef NO_ACTION_TAPPING
+    next = MIN(next, action_tapping_time_until_next());
+#endif
+#ifdef COMBO_ENABLE
+    next = MIN(next, combo_time_until_next());
+#endif
+#ifdef TAP_DANCE_ENABLE
+    next = MIN(next, tap_dance_time_until_next());
+#endif
+#ifdef LEADER_ENABLE
+    next = MIN(next, leader_time_until_next());
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+    next = MIN(next, deferred_exec_time_until_next());
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    next = MIN(next, rgb_matrix_time_until_next());
+#endif
+#ifdef LED_MATRIX_ENABLE
+    next = MIN(next, led_matrix_time_until_next());
+#endif
+#ifdef OLED_ENABLE
+    next = MIN(next, oled_time_until_next());
+#endif
+#ifdef WPM_ENABLE
+    next = MIN(next, wpm_time_until_next());
+#endif
+#ifdef RGBLIGHT_ENABLE
+    next = MIN(next, rgblight_time_until_next());
+#endif
+#ifdef BACKLIGHT_ENABLE
+    next = MIN(next, backlight_time_until_next());
+#endif
+#ifdef ENCODER_ENABLE
+    next = MIN(next, encoder_time_until_next());
+#endif
+#ifdef POINTING_DEVICE_ENABLE
+    next = MIN(next, pointing_device_time_until_next());
+#endif
+#ifdef MOUSEKEY_ENABLE
+    next = MIN(next, mousekey_time_until_next());
+#endif
+#ifdef HAPTIC_ENABLE
+    next = MIN(next, haptic_time_until_next());
+#endif
+#ifdef AUDIO_ENABLE
+    next = MIN(next, audio_time_until_next());
+#    ifndef NO_MUSIC_MODE
+    next = MIN(next, music_time_until_next());
+#    endif
+#endif
+#ifdef CAPS_WORD_ENABLE
+    next = MIN(next, caps_word_time_until_next());
+#endif
+
+    return tickless_idle_time_until_next_kb(next);
+}
+
+static bool tickless_idle_keys_released(void) {
+#ifdef MATRIX_EVENT_DRIVEN_SCAN
+    // Also covers keys which are still being debounced
+    if (!matrix_is_idle()) {
+        return false;
+    }
+#endif
+#if !defined(MATRIX_EVENT_DRIVEN_SCAN) || defined(SPLIT_KEYBOARD)
+    // On the master, this includes the keys held on the other half
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+void tickless_idle_task(void) {
+    if (!tickless_idle_keys_released()) {
+        return;
+    }
+
+    uint32_t next = MIN(tickless_idle_time_until_next(), TICKLESS_IDLE_MAX_SLEEP);
+    if (next > 0) {
+        tickless_idle_sleep(next);
+    }
+}
+
+#if defined(PROTOCOL_CHIBIOS)
+static thread_reference_t tickless_idle_thread = NULL;
+
+__attribute__((weak)) void tickless_idle_sleep(uint32_t ms) {
+    // The idle thread runs WFI until the timeout or a wakeup
+    chSysLock();
+    chThdSuspendTimeoutS(&tickless_idle_thread, TIME_MS2I(ms));
+    chSysUnlock();
+}
+
+void tickless_idle_wake_from_isr(void) {
+    chSysLockFromISR();
+    chThdResumeI(&tickless_idle_thread, MSG_OK);
+    chSysUnlockFromISR();
+}
+#elif defined(__AVR__)
+static volatile bool tickless_idle_woken = false;
+
+__attribute__((weak)) void tickless_idle_sleep(uint32_t ms) {
+    // Idle mode keeps the millisecond timer running, which wakes the CPU on every tick
+    uint32_t start      = timer_read32();
+    tickless_idle_woken = false;
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while (!tickless_idle_woken && timer_elapsed32(start) < ms) {
+        sleep_mode();
+    }
+}
+
+void tickless_idle_wake_from_isr(void) {
+    tickless_idle_woken = true;
+}
+#else
+__attribute__((weak)) void tickless_idle_sleep(uint32_t ms) {}
+
+void tickless_idle_wake_from_isr(void) {}
+#endif
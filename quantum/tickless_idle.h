@@ -0,0 +1,68 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+    Tickless idle.
+
+    While no keys are held, each timed subsystem reports how long it can wait
+    before it next needs to run, and the main loop sleeps until the earliest
+    of those deadlines instead of spinning through keyboard_task().
+
+    Keyboards which can raise an interrupt on a key press should call
+    tickless_idle_wake_from_isr() from it, and may then raise
+    TICKLESS_IDLE_MAX_SLEEP.
+*/
+
+// Longest single sleep, which bounds the latency of a key press that can't wake the MCU
+#ifndef TICKLESS_IDLE_MAX_SLEEP
+#    define TICKLESS_IDLE_MAX_SLEEP 10
+#endif
+
+#define TICKLESS_IDLE_NO_DEADLINE UINT32_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Time until the earliest subsystem deadline.
+ *
+ * @return milliseconds until something needs to run, or TICKLESS_IDLE_NO_DEADLINE
+ */
+uint32_t tickless_idle_time_until_next(void);
+
+/**
+ * @brief Keyboard and user level hooks to report additional deadlines.
+ *
+ * @param next the earliest deadline found so far
+ * @return the earliest deadline including any of the keyboard's own
+ */
+uint32_t tickless_idle_time_until_next_kb(uint32_t next);
+uint32_t tickless_idle_time_until_next_user(uint32_t next);
+
+/**
+ * @brief Sleep until the next deadline, if the keyboard is idle.
+ *
+ * Called from the main loop, should not be invoked by keyboard/user code.
+ */
+void tickless_idle_task(void);
+
+/**
+ * @brief Put the MCU to sleep for up to the given time.
+ *
+ * Platform specific, can be overridden by a keyboard with a deeper sleep mode.
+ */
+void tickless_idle_sleep(uint32_t ms);
+
+/**
+ * @brief End the current sleep early, from an interrupt handler.
+ */
+void tickless_idle_wake_from_isr(void);
+
+#ifdef __cplusplus
+}
+#endif
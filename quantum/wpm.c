@@ -121,6 +121,26 @@ void update_wpm(uint16_t keycode) {
 #endif
 }
 
+uint32_t wpm_time_until_next(void) {
+    int32_t presses = period_presses[0];
+    for (int i = 1; i <= periods; i++) {
+        presses += period_presses[i];
+    }
+    if (presses <= 0 && current_wpm == 0) {
+        // Nothing left to decay
+        return UINT32_MAX;
+    }
+
+    uint32_t elapsed = timer_elapsed32(wpm_timer);
+    uint32_t next    = elapsed <= PERIOD_DURATION ? PERIOD_DURATION - elapsed + 1 : 0;
+#if !defined(WPM_UNFILTERED)
+    // The smoothed value is only resampled every LATENCY ms
+    uint32_t latency = timer_elapsed32(smoothing_timer);
+    next             = MIN(next, latency <= LATENCY ? LATENCY - latency + 1 : 0);
+#endif
+    return next;
+}
+
 void decay_wpm(void) {
     int32_t presses = period_presses[0];
     for (int i = 1; i <= periods; i++) {
@@ -42,4 +42,5 @@ void    set_current_wpm(uint8_t);
 uint8_t get_current_wpm(void);
 void    update_wpm(uint16_t);
 
-void decay_wpm(void);
+void     decay_wpm(void);
+uint32_t wpm_time_until_next(void);
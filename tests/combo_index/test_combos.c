@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+enum combos { ab, abc, cd, ad };
+
+uint16_t const ab_combo[]  = {KC_A, KC_B, COMBO_END};
+uint16_t const abc_combo[] = {KC_C, KC_B, KC_A, COMBO_END};
+uint16_t const cd_combo[]  = {KC_C, KC_D, COMBO_END};
+uint16_t const ad_combo[]  = {KC_D, KC_A, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [ab]  = COMBO(ab_combo, KC_W),
+    [abc] = COMBO(abc_combo, KC_X),
+    [cd]  = COMBO(cd_combo, KC_Y),
+    [ad]  = COMBO(ad_combo, KC_Z)
+};
+// clang-format on
@@ -0,0 +1,139 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "latency_trace.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LatencyTrace : public TestFixture {
+   protected:
+    void SetUp() override {
+        latency_trace_clear();
+    }
+
+    latency_trace_t expect_trace(KeymapKey &key, bool pressed) {
+        latency_trace_t trace = {};
+        EXPECT_TRUE(latency_trace_read(&trace));
+        EXPECT_TRUE(KEYEQ(trace.key, key.position));
+        EXPECT_EQ(trace.pressed, pressed);
+        return trace;
+    }
+};
+
+TEST_F(LatencyTrace, regular_key_is_reported_in_the_same_scan) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({regular_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key, 5);
+    VERIFY_AND_CLEAR(driver);
+
+    latency_trace_t trace = expect_trace(regular_key, true);
+    EXPECT_EQ(latency_trace_total(&trace), 0);
+    trace = expect_trace(regular_key, false);
+    EXPECT_EQ(latency_trace_total(&trace), 0);
+
+    EXPECT_FALSE(latency_trace_read(&trace));
+}
+
+TEST_F(LatencyTrace, tapped_mod_tap_is_held_by_tapping_until_release) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_trace_t trace = expect_trace(mod_tap_key, true);
+    EXPECT_EQ(trace.combo_time, 0);
+    EXPECT_EQ(trace.tapping_time, 20);
+    EXPECT_EQ(trace.deferred_time, 0);
+
+    trace = expect_trace(mod_tap_key, false);
+    EXPECT_EQ(latency_trace_total(&trace), 0);
+}
+
+TEST_F(LatencyTrace, held_mod_tap_is_held_by_tapping_for_the_tapping_term) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_trace_t trace = expect_trace(mod_tap_key, true);
+    EXPECT_EQ(trace.tapping_time, TAPPING_TERM);
+    EXPECT_EQ(trace.deferred_time, 0);
+    EXPECT_LE(latency_trace_total(&trace), TAPPING_TERM);
+}
+
+TEST_F(LatencyTrace, combo_keys_are_held_by_combo_until_resolved) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_j = KeymapKey(0, 1, 0, KC_J);
+    auto       key_k = KeymapKey(0, 2, 0, KC_K);
+
+    set_keymap({key_j, key_k});
+
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    key_j.press();
+    idle_for(10);
+    key_k.press();
+    idle_for(COMBO_TERM + 5);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_j.release();
+    idle_for(10);
+    key_k.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Both presses are held until the combo term expires after the last one
+    latency_trace_t trace_j = expect_trace(key_j, true);
+    latency_trace_t trace   = expect_trace(key_k, true);
+    EXPECT_GE(trace.combo_time, COMBO_TERM);
+    EXPECT_EQ(trace_j.combo_time, trace.combo_time + 10);
+    EXPECT_EQ(trace.tapping_time, 0);
+    EXPECT_EQ(trace.deferred_time, 0);
+
+    // The first release is held until the combo is released with the last key
+    trace = expect_trace(key_j, false);
+    EXPECT_EQ(trace.combo_time, 10);
+    EXPECT_EQ(trace.tapping_time, 0);
+    EXPECT_EQ(trace.deferred_time, 0);
+    trace = expect_trace(key_k, false);
+    EXPECT_EQ(latency_trace_total(&trace), 0);
+
+    EXPECT_FALSE(latency_trace_read(&trace));
+}
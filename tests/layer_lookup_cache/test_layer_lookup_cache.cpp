@@ -0,0 +1,97 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerLookupCache : public TestFixture {};
+
+TEST_F(LayerLookupCache, transparent_keys_fall_through) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key, KeymapKey(1, 1, 0, KC_TRNS), KeymapKey(2, 1, 0, KC_B)});
+
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 2);
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, changes_below_the_resolved_layer_are_ignored) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key, KeymapKey(1, 1, 0, KC_B), KeymapKey(2, 1, 0, KC_C)});
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 2);
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 2);
+    default_layer_set(0);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 2);
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 1);
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    default_layer_set(1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, direct_layer_state_assignment_is_seen) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key, KeymapKey(1, 1, 0, KC_B)});
+
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+    // As done by the split transport on the slave half
+    layer_state = (layer_state_t)1 << 1;
+    EXPECT_EQ(layer_switch_get_layer(key.position), 1);
+    layer_state = 0;
+    EXPECT_EQ(layer_switch_get_layer(key.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, momentary_layer_switches_keycode) {
+    TestDriver driver;
+    InSequence s;
+    auto       layer_key   = KeymapKey(0, 0, 0, MO(1));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({layer_key, regular_key, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(1, 1, 0, KC_B)});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,178 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+// Typed keys in the order they first appeared in a report, with the mods active at the time
+struct TypedKey {
+    uint8_t code;
+    uint8_t mods;
+
+    bool operator==(const TypedKey &other) const {
+        return code == other.code && mods == other.mods;
+    }
+};
+
+static std::ostream &operator<<(std::ostream &os, const TypedKey &key) {
+    return os << "{" << (int)key.code << ", mods=" << (int)key.mods << "}";
+}
+
+class RollingStress : public TestFixture {
+   protected:
+    std::vector<TypedKey> typed;
+    std::vector<uint8_t>  held;
+
+    void record_reports(TestDriver &driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([this](report_keyboard_t &report) {
+            std::vector<uint8_t> now;
+            for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                if (report.keys[i] != KC_NO) {
+                    now.push_back(report.keys[i]);
+                    if (std::find(held.begin(), held.end(), report.keys[i]) == held.end()) {
+                        typed.push_back({report.keys[i], report.mods});
+                    }
+                }
+            }
+            held = now;
+        }));
+    }
+
+    // Press a key every interval ms, and release it hold ms later
+    void roll(std::vector<KeymapKey> &keys, uint32_t interval, uint32_t hold) {
+        uint32_t end = (keys.size() - 1) * interval + hold;
+        for (uint32_t t = 0; t <= end; t++) {
+            for (size_t i = 0; i < keys.size(); i++) {
+                if (t == i * interval) {
+                    keys[i].press();
+                } else if (t == i * interval + hold) {
+                    keys[i].release();
+                }
+            }
+            run_one_scan_loop();
+        }
+    }
+};
+
+// 200 WPM is a key every 60ms, with each key held until after the next one is pressed
+TEST_F(RollingStress, rolled_home_row_mods_at_200_wpm_are_all_tapped) {
+    TestDriver             driver;
+    const uint8_t          mods[] = {MOD_LSFT, MOD_LCTL, MOD_LALT, MOD_LGUI};
+    std::vector<KeymapKey> keys;
+    std::vector<TypedKey>  expected;
+
+    for (uint8_t i = 0; i < 16; i++) {
+        keys.push_back(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, MT(mods[i % 4], KC_A + i)));
+        expected.push_back({(uint8_t)(KC_A + i), 0});
+    }
+    for (auto &key : keys) {
+        add_key(key);
+    }
+
+    record_reports(driver);
+    roll(keys, 60, 90);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(typed, expected);
+    EXPECT_TRUE(held.empty());
+}
+
+// A burst under a mod-tap key released within its tapping term leaves it a tap
+TEST_F(RollingStress, burst_under_mod_tap_key_released_within_tapping_term_is_tapped) {
+    TestDriver             driver;
+    auto                   mod_tap_key = KeymapKey(0, 9, 3, SFT_T(KC_P));
+    std::vector<KeymapKey> keys;
+    std::vector<TypedKey>  expected = {{KC_P, 0}};
+
+    for (uint8_t i = 0; i < 16; i++) {
+        keys.push_back(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, KC_A + i));
+        expected.push_back({(uint8_t)(KC_A + i), 0});
+    }
+    set_keymap({mod_tap_key});
+    for (auto &key : keys) {
+        add_key(key);
+    }
+
+    record_reports(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    roll(keys, 10, 15);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(typed, expected);
+    EXPECT_TRUE(held.empty());
+}
+
+// A burst which just fits in the waiting buffer is still resolved by the mod-tap release
+TEST_F(RollingStress, burst_within_waiting_buffer_keeps_tap) {
+    TestDriver             driver;
+    auto                   mod_tap_key = KeymapKey(0, 9, 3, SFT_T(KC_P));
+    std::vector<KeymapKey> keys;
+    std::vector<TypedKey>  expected = {{KC_P, 0}};
+
+    for (uint8_t i = 0; i < (WAITING_BUFFER_SIZE - 1) / 2; i++) {
+        keys.push_back(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, KC_A + i));
+        expected.push_back({(uint8_t)(KC_A + i), 0});
+    }
+    set_keymap({mod_tap_key});
+    for (auto &key : keys) {
+        add_key(key);
+    }
+
+    record_reports(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    roll(keys, 3, 5);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(typed, expected);
+    EXPECT_TRUE(held.empty());
+}
+
+// A burst which doesn't fit in the waiting buffer settles the mod-tap key as a hold early, without dropping any keys
+TEST_F(RollingStress, burst_overflowing_waiting_buffer_under_held_mod_tap_key_is_not_dropped) {
+    TestDriver             driver;
+    auto                   mod_tap_key = KeymapKey(0, 9, 3, SFT_T(KC_P));
+    std::vector<KeymapKey> keys;
+    std::vector<TypedKey>  expected;
+
+    for (uint8_t i = 0; i < WAITING_BUFFER_SIZE / 2; i++) {
+        keys.push_back(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, KC_A + i));
+        expected.push_back({(uint8_t)(KC_A + i), MOD_BIT(KC_LSFT)});
+    }
+    set_keymap({mod_tap_key});
+    for (auto &key : keys) {
+        add_key(key);
+    }
+
+    record_reports(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    roll(keys, 3, 5);
+    // Held past its tapping term, so a hold is what the mod-tap key resolves to anyway
+    idle_for(TAPPING_TERM);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_LT((WAITING_BUFFER_SIZE / 2 - 1) * 3 + 5, TAPPING_TERM);
+    EXPECT_EQ(typed, expected);
+    EXPECT_TRUE(held.empty());
+}
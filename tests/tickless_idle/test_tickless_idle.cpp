@@ -0,0 +1,134 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "deferred_exec.h"
+#include "caps_word.h"
+#include "tickless_idle.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+static std::vector<uint32_t> sleeps;
+static uint32_t              kb_deadline = TICKLESS_IDLE_NO_DEADLINE;
+
+extern "C" void tickless_idle_sleep(uint32_t ms) {
+    sleeps.push_back(ms);
+}
+
+extern "C" uint32_t tickless_idle_time_until_next_kb(uint32_t next) {
+    return MIN(next, kb_deadline);
+}
+
+static uint32_t noop_callback(uint32_t trigger_time, void *cb_arg) {
+    return 0;
+}
+
+class TicklessIdle : public TestFixture {
+   protected:
+    void SetUp() override {
+        sleeps.clear();
+        kb_deadline = TICKLESS_IDLE_NO_DEADLINE;
+    }
+};
+
+TEST_F(TicklessIdle, sleeps_for_the_longest_allowed_time_when_nothing_is_due) {
+    TestDriver driver;
+    EXPECT_EQ(tickless_idle_time_until_next(), TICKLESS_IDLE_NO_DEADLINE);
+
+    tickless_idle_task();
+    EXPECT_EQ(sleeps, std::vector<uint32_t>({TICKLESS_IDLE_MAX_SLEEP}));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TicklessIdle, does_not_sleep_while_a_key_is_held) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 0, KC_A);
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    tickless_idle_task();
+    EXPECT_TRUE(sleeps.empty());
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TicklessIdle, wakes_up_for_the_tapping_term) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    set_keymap({mod_tap_key});
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(mod_tap_key);
+    VERIFY_AND_CLEAR(driver);
+
+    // The released tap stays the tapping key until its term has passed
+    uint32_t next = tickless_idle_time_until_next();
+    EXPECT_GT(next, 0);
+    EXPECT_LE(next, TAPPING_TERM);
+
+    tickless_idle_task();
+    EXPECT_EQ(sleeps, std::vector<uint32_t>({MIN(next, TICKLESS_IDLE_MAX_SLEEP)}));
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(tickless_idle_time_until_next(), TICKLESS_IDLE_NO_DEADLINE);
+}
+
+TEST_F(TicklessIdle, wakes_up_for_deferred_executors) {
+    TestDriver     driver;
+    deferred_token token = defer_exec(42, noop_callback, NULL);
+
+    EXPECT_EQ(tickless_idle_time_until_next(), 42);
+    idle_for(2);
+    EXPECT_EQ(tickless_idle_time_until_next(), 40);
+
+    cancel_deferred_exec(token);
+    EXPECT_EQ(tickless_idle_time_until_next(), TICKLESS_IDLE_NO_DEADLINE);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TicklessIdle, wakes_up_for_the_caps_word_timeout) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    caps_word_on();
+    EXPECT_EQ(tickless_idle_time_until_next(), CAPS_WORD_IDLE_TIMEOUT);
+    idle_for(1000);
+    EXPECT_EQ(tickless_idle_time_until_next(), CAPS_WORD_IDLE_TIMEOUT - 1000);
+
+    idle_for(CAPS_WORD_IDLE_TIMEOUT - 1000);
+    EXPECT_EQ(tickless_idle_time_until_next(), 0);
+    run_one_scan_loop();
+    EXPECT_FALSE(is_caps_word_on());
+    EXPECT_EQ(tickless_idle_time_until_next(), TICKLESS_IDLE_NO_DEADLINE);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TicklessIdle, keyboard_can_add_deadlines) {
+    TestDriver driver;
+    kb_deadline = 7;
+
+    tickless_idle_task();
+    EXPECT_EQ(sleeps, std::vector<uint32_t>({7}));
+
+    kb_deadline = 0;
+    tickless_idle_task();
+    EXPECT_EQ(sleeps, std::vector<uint32_t>({7}));
+    VERIFY_AND_CLEAR(driver);
+}